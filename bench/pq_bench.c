@@ -0,0 +1,909 @@
+
+
+/************************************************************************************
+    Benchmark suite of Double Ended Priority Queue ADT
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+/*
+ *  Runs every access pattern below over every storage engine, for every size n:
+ *
+ *      random          insert n random keys, peek the minimum n times, pull all
+ *      monotonic       insert n increasing timestamps, pull all
+ *      hold            insert n random keys, then n times pull the minimum and
+ *                      insert a key a random delay after it (event simulation),
+ *                      pull all
+ *      alternating     insert n random keys, then peek and pull the minimum and
+ *                      the maximum in turn
+ *      decrease_key    insert n random keys with handles, decrease every key
+ *                      through its handle, reassign a few keys by element
+ *                      (an O(n) scan each), pull all
+ *      burst           4 times: insert n random keys into a queue which starts
+ *                      small, then drain it (growth & shrinking)
+ *      dijkstra        shortest paths from vertex 0 of a random graph of n vertices
+ *                      with 8 edges each, the distances are lowered through handles
+ *      prim            spanning tree of the same graph, the keys are edge weights
+ *
+ *  The radix engine takes the keys as unsigned integers. The keys of the later
+ *  bursts (and the edge weights of prim) are below the last pulled minimum,
+ *  so it falls back to the binary heap in those patterns.
+ *
+ *  The operations are timed in batches of 64, which gives the throughput and
+ *  the percentiles of the cost per operation. The memory is the peak of the
+ *  bytes owned by the queue so far, counted by its allocator.
+ *
+ *  Build:
+ *      gcc -std=c99 -O2 -DNDEBUG -Iinclude src/pq_*.c bench/pq_bench.c -o pq_bench -pthread
+ *
+ *  Usage:
+ *      ./pq_bench [--format=table|csv|json] [--engine=NAME] [--pattern=NAME] [n ...]
+ *                                  (default n is 1000 10000 100000 1000000, up to 100000000)
+ *      csv has a header line, json prints one object per line.
+*/
+
+
+
+
+#define _POSIX_C_SOURCE 199309L
+
+#include "pq.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+
+
+#define PQ_BENCH_MAXIMUM_SIZE           100000000u
+#define PQ_BENCH_INITIAL_CAPACITY       16u
+#define PQ_BENCH_BATCH                  64u         /* Operations per timed sample */
+#define PQ_BENCH_BURSTS                 4u
+#define PQ_BENCH_SCAN_BUDGET            200000000u  /* Nodes visited by the reassign scans */
+#define PQ_BENCH_SCAN_LIMIT             1000u
+#define PQ_BENCH_GRAPH_DEGREE           8u          /* Edges leaving every vertex of the graph patterns */
+
+
+#define PQ_BENCH_FORMAT_TABLE           0
+#define PQ_BENCH_FORMAT_CSV             1
+#define PQ_BENCH_FORMAT_JSON            2
+
+
+
+
+/* Timed samples of one kind of operation */
+struct BenchSeries_ {
+    
+    double *pSample;                        /* Nanoseconds per operation of every batch */
+    size_t sampleCount;
+    size_t sampleCapacity;
+    unsigned long long opCount;
+    double seconds;
+    double lapStart;
+    unsigned int lapOps;
+};
+
+
+/* Everything one pattern needs for one engine and one size */
+struct BenchRun_ {
+    
+    enum PQ_Engine_t engine;
+    const char *engineName;
+    const char *patternName;
+    unsigned int n;
+    unsigned int *pKey;                     /* n random keys */
+    unsigned int *pAltKey;                  /* n keys derived by the pattern */
+    PQhandle *pHandle;
+    struct BenchSeries_ series[2];
+    int format;
+};
+
+
+
+
+static const struct {
+    enum PQ_Engine_t engine;
+    const char *name;
+} benchEngines[] = {
+    { PQ_ENGINE_BINARY_HEAP,    "binary"    },
+    { PQ_ENGINE_DARY4_HEAP,     "4-ary"     },
+    { PQ_ENGINE_DARY8_HEAP,     "8-ary"     },
+    { PQ_ENGINE_MINMAX_HEAP,    "min-max"   },
+    { PQ_ENGINE_RADIX_HEAP,     "radix"     },
+    { PQ_ENGINE_PAIRING_HEAP,   "pairing"   }
+};
+
+
+
+
+/* Bytes currently owned by the queue under test, and their peak */
+static size_t benchBytes, benchPeak;
+
+
+
+
+
+static int bench_compare(const void *a, const void *b) {
+    
+    unsigned int x, y;
+    
+    
+    x = *((const unsigned int *) a);
+    y = *((const unsigned int *) b);
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+
+
+
+
+static unsigned long long bench_key(const void *priority) {
+    
+    return *((const unsigned int *) priority);
+}
+
+
+
+
+
+static int bench_same_element(const void *a, const void *b) {
+    
+    return a == b ? 0 : 1;
+}
+
+
+
+
+
+static int bench_compare_double(const void *a, const void *b) {
+    
+    double x, y;
+    
+    
+    x = *((const double *) a);
+    y = *((const double *) b);
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+
+
+
+
+static double bench_seconds(void) {
+    
+    struct timespec ts;
+    
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+
+
+
+
+static void *bench_alloc(void *context, size_t size) {
+    
+    void *block;
+    
+    
+    (void) context;
+    block = malloc(size);
+    if (block != 0) {
+        benchBytes += size;
+        benchPeak = benchBytes > benchPeak ? benchBytes : benchPeak;
+    }
+    return block;
+}
+
+
+
+
+
+static void *bench_realloc(void *context, void *block, size_t oldSize, size_t newSize) {
+    
+    void *newBlock;
+    
+    
+    (void) context;
+    newBlock = realloc(block, newSize);
+    if (newBlock != 0) {
+        benchBytes = benchBytes - (block != 0 ? oldSize : 0) + newSize;
+        benchPeak = benchBytes > benchPeak ? benchBytes : benchPeak;
+    }
+    return newBlock;
+}
+
+
+
+
+
+static void bench_free(void *context, void *block, size_t size) {
+    
+    (void) context;
+    if (block != 0)
+        benchBytes -= size;
+    free(block);
+}
+
+
+
+
+
+static const PQallocator benchAllocator = { bench_alloc, bench_realloc, bench_free, 0 };
+
+
+
+
+
+static void bench_series_start(struct BenchSeries_ *pSeries) {
+    
+    pSeries->sampleCount = 0;
+    pSeries->opCount = 0;
+    pSeries->seconds = 0.0;
+    pSeries->lapOps = 0;
+    pSeries->lapStart = bench_seconds();
+}
+
+
+
+
+
+/* Close the current batch, and start the next one */
+static void bench_series_lap(struct BenchSeries_ *pSeries) {
+    
+    double now, elapsed;
+    
+    
+    now = bench_seconds();
+    elapsed = now - pSeries->lapStart;
+    if (pSeries->lapOps != 0 && pSeries->sampleCount < pSeries->sampleCapacity) {
+        pSeries->pSample[pSeries->sampleCount] = elapsed * 1e9 / pSeries->lapOps;
+        pSeries->sampleCount += 1;
+        pSeries->seconds += elapsed;
+        pSeries->opCount += pSeries->lapOps;
+    }
+    pSeries->lapOps = 0;
+    pSeries->lapStart = bench_seconds();
+}
+
+
+
+
+
+/* Count one operation */
+static void bench_series_tick(struct BenchSeries_ *pSeries) {
+    
+    pSeries->lapOps += 1;
+    if (pSeries->lapOps == PQ_BENCH_BATCH)
+        bench_series_lap(pSeries);
+}
+
+
+
+
+
+/* Continue a series after a pause (the time in between is not counted) */
+static void bench_series_resume(struct BenchSeries_ *pSeries) {
+    
+    pSeries->lapOps = 0;
+    pSeries->lapStart = bench_seconds();
+}
+
+
+
+
+
+static void bench_report(struct BenchRun_ *run, const char *operation, struct BenchSeries_ *pSeries) {
+    
+    double rate, p50, p90, p99, pMax;
+    size_t last;
+    
+    
+    if (pSeries->sampleCount == 0)
+        return;
+    
+    qsort((void *) pSeries->pSample, pSeries->sampleCount, sizeof(double), bench_compare_double);
+    last = pSeries->sampleCount - 1;
+    p50 = pSeries->pSample[last * 50 / 100];
+    p90 = pSeries->pSample[last * 90 / 100];
+    p99 = pSeries->pSample[last * 99 / 100];
+    pMax = pSeries->pSample[last];
+    rate = pSeries->seconds > 0.0 ? (double) pSeries->opCount / pSeries->seconds : 0.0;
+    
+    switch (run->format) {
+        case PQ_BENCH_FORMAT_CSV:
+            printf("%s,%s,%s,%u,%llu,%.0f,%.1f,%.1f,%.1f,%.1f,%lu\n",
+                        run->engineName, run->patternName, operation, run->n, pSeries->opCount,
+                        rate, p50, p90, p99, pMax, (unsigned long) benchPeak);
+            break;
+        case PQ_BENCH_FORMAT_JSON:
+            printf("{\"engine\":\"%s\",\"pattern\":\"%s\",\"operation\":\"%s\",\"elements\":%u,"
+                   "\"operations\":%llu,\"ops_per_sec\":%.0f,\"ns_p50\":%.1f,\"ns_p90\":%.1f,"
+                   "\"ns_p99\":%.1f,\"ns_max\":%.1f,\"peak_bytes\":%lu}\n",
+                        run->engineName, run->patternName, operation, run->n, pSeries->opCount,
+                        rate, p50, p90, p99, pMax, (unsigned long) benchPeak);
+            break;
+        default:
+            printf("%-8s %-13s %-16s %10u %12.3f %9.1f %9.1f %9.1f %11.1f %10.2f\n",
+                        run->engineName, run->patternName, operation, run->n,
+                        rate * 1e-6, p50, p90, p99, pMax, (double) benchPeak / (1024.0 * 1024.0));
+    }
+}
+
+
+
+
+
+static int bench_init_queue(struct BenchRun_ *run, PriorityQueue *pq) {
+    
+    benchBytes = 0;
+    benchPeak = 0;
+    if (run->engine == PQ_ENGINE_RADIX_HEAP)
+        return pq_init_radix(pq, PQ_BENCH_INITIAL_CAPACITY, &benchAllocator, bench_key,
+                             bench_compare, 0, 0);
+    return pq_init_allocator(pq, run->engine, PQ_HEAP_MIN, PQ_BENCH_INITIAL_CAPACITY,
+                             &benchAllocator, bench_compare, 0, 0);
+}
+
+
+
+
+
+/* Insert all the keys of the given array, timed as one series */
+static int bench_insert_all(struct BenchRun_ *run, PriorityQueue *pq, const unsigned int *pKey,
+                            const char *operation) {
+    
+    struct BenchSeries_ *pSeries;
+    unsigned int index;
+    
+    
+    pSeries = run->series + 0;
+    bench_series_start(pSeries);
+    for (index = 0; index < run->n; index += 1) {
+        if (pq_insert_with_priority(pq, pKey + index, pKey + index) != 0)
+            return -1;
+        bench_series_tick(pSeries);
+    }
+    bench_series_lap(pSeries);
+    
+    if (operation != 0)
+        bench_report(run, operation, pSeries);
+    return 0;
+}
+
+
+
+
+
+/* Pull every element from the minimum end, timed as one series */
+static int bench_pull_all(struct BenchRun_ *run, PriorityQueue *pq) {
+    
+    struct BenchSeries_ *pSeries;
+    void *priority, *elem;
+    
+    
+    pSeries = run->series + 1;
+    bench_series_start(pSeries);
+    while (pq_size(pq) != 0) {
+        if (pq_pull_minimum(pq, &priority, &elem) != 0)
+            return -1;
+        bench_series_tick(pSeries);
+    }
+    bench_series_lap(pSeries);
+    
+    bench_report(run, "pull_min", pSeries);
+    return 0;
+}
+
+
+
+
+
+static int bench_pattern_random(struct BenchRun_ *run) {
+    
+    PriorityQueue pq;
+    struct BenchSeries_ *pSeries;
+    unsigned int index;
+    void *priority, *elem;
+    int result;
+    
+    
+    if (bench_init_queue(run, &pq) != 0)
+        return -1;
+    
+    result = bench_insert_all(run, &pq, run->pKey, "insert");
+    if (result == 0) {
+        pSeries = run->series + 1;
+        bench_series_start(pSeries);
+        for (index = 0; index < run->n; index += 1) {
+            pq_peek_minimum(&pq, &priority, &elem);
+            bench_series_tick(pSeries);
+        }
+        bench_series_lap(pSeries);
+        bench_report(run, "peek_min", pSeries);
+    
+        result = bench_pull_all(run, &pq);
+    }
+    
+    pq_destroy(&pq);
+    return result;
+}
+
+
+
+
+
+static int bench_pattern_monotonic(struct BenchRun_ *run) {
+    
+    PriorityQueue pq;
+    unsigned int index;
+    int result;
+    
+    
+    /* Increasing timestamps, 16 ticks apart with some jitter */
+    for (index = 0; index < run->n; index += 1)
+        run->pAltKey[index] = index * 16 + (run->pKey[index] & 15);
+    
+    if (bench_init_queue(run, &pq) != 0)
+        return -1;
+    
+    result = bench_insert_all(run, &pq, run->pAltKey, "insert");
+    if (result == 0)
+        result = bench_pull_all(run, &pq);
+    
+    pq_destroy(&pq);
+    return result;
+}
+
+
+
+
+
+static int bench_pattern_hold(struct BenchRun_ *run) {
+    
+    PriorityQueue pq;
+    struct BenchSeries_ *pSeries;
+    unsigned int index, minimum;
+    void *priority, *elem;
+    int result;
+    
+    
+    if (bench_init_queue(run, &pq) != 0)
+        return -1;
+    
+    /* The earliest event is handled and schedules a new one, the size stays n */
+    result = bench_insert_all(run, &pq, run->pKey, "insert");
+    if (result == 0) {
+        pSeries = run->series + 1;
+        bench_series_start(pSeries);
+        for (index = 0; index < run->n && result == 0; index += 1) {
+            result = pq_pull_minimum(&pq, &priority, &elem);
+            if (result != 0)
+                break;
+            minimum = *((const unsigned int *) priority);
+            run->pAltKey[index] = minimum + (run->pKey[index] & 0xFFFFu);
+            if (run->pAltKey[index] < minimum)
+                run->pAltKey[index] = minimum;
+            result = pq_insert_with_priority(&pq, run->pAltKey + index, run->pAltKey + index);
+            bench_series_tick(pSeries);
+        }
+        bench_series_lap(pSeries);
+        bench_report(run, "hold", pSeries);
+    
+        if (result == 0)
+            result = bench_pull_all(run, &pq);
+    }
+    
+    pq_destroy(&pq);
+    return result;
+}
+
+
+
+
+
+static int bench_pattern_alternating(struct BenchRun_ *run) {
+    
+    PriorityQueue pq;
+    struct BenchSeries_ *pSeries;
+    unsigned int index;
+    void *priority, *elem;
+    int result;
+    
+    
+    if (bench_init_queue(run, &pq) != 0)
+        return -1;
+    
+    result = bench_insert_all(run, &pq, run->pKey, "insert");
+    if (result == 0) {
+        pSeries = run->series + 1;
+        bench_series_start(pSeries);
+        for (index = 0; index < run->n; index += 1) {
+            if ((index & 1) == 0)
+                pq_peek_minimum(&pq, &priority, &elem);
+            else
+                pq_peek_maximum(&pq, &priority, &elem);
+            bench_series_tick(pSeries);
+        }
+        bench_series_lap(pSeries);
+        bench_report(run, "peek_min_max", pSeries);
+    
+        bench_series_start(pSeries);
+        for (index = 0; index < run->n && result == 0; index += 1) {
+            if ((index & 1) == 0)
+                result = pq_pull_minimum(&pq, &priority, &elem);
+            else
+                result = pq_pull_maximum(&pq, &priority, &elem);
+            bench_series_tick(pSeries);
+        }
+        bench_series_lap(pSeries);
+        bench_report(run, "pull_min_max", pSeries);
+    }
+    
+    pq_destroy(&pq);
+    return result;
+}
+
+
+
+
+
+static int bench_pattern_decrease_key(struct BenchRun_ *run) {
+    
+    PriorityQueue pq;
+    struct BenchSeries_ *pSeries;
+    unsigned int index, scanCount, step;
+    int result;
+    
+    
+    for (index = 0; index < run->n; index += 1)
+        run->pAltKey[index] = run->pKey[index] / 2;
+    
+    if (bench_init_queue(run, &pq) != 0)
+        return -1;
+    
+    
+    /* The element is the address of its original key, which stays the same */
+    result = 0;
+    pSeries = run->series + 0;
+    bench_series_start(pSeries);
+    for (index = 0; index < run->n && result == 0; index += 1) {
+        result = pq_insert_with_handle(&pq, run->pKey + index, run->pKey + index, run->pHandle + index);
+        bench_series_tick(pSeries);
+    }
+    bench_series_lap(pSeries);
+    bench_report(run, "insert_handle", pSeries);
+    
+    if (result == 0) {
+        bench_series_start(pSeries);
+        for (index = 0; index < run->n && result == 0; index += 1) {
+            result = pq_reassign_priority_handle(&pq, run->pHandle[index], run->pAltKey + index, 0);
+            bench_series_tick(pSeries);
+        }
+        bench_series_lap(pSeries);
+        bench_report(run, "reassign_handle", pSeries);
+    }
+    
+    
+    /* Every reassign by element scans the array, only a few fit in the budget */
+    if (result == 0) {
+        scanCount = PQ_BENCH_SCAN_BUDGET / run->n;
+        scanCount = scanCount < 1 ? 1 : scanCount > PQ_BENCH_SCAN_LIMIT ? PQ_BENCH_SCAN_LIMIT : scanCount;
+        scanCount = scanCount > run->n ? run->n : scanCount;
+        step = run->n / scanCount;
+        bench_series_start(pSeries);
+        for (index = 0; index < scanCount && result == 0; index += 1) {
+            result = pq_reassign_priority(&pq, bench_same_element, run->pKey + index * step,
+                                          run->pKey + index * step, 0);
+            bench_series_tick(pSeries);
+        }
+        bench_series_lap(pSeries);
+        bench_report(run, "reassign_scan", pSeries);
+    }
+    
+    if (result == 0)
+        result = bench_pull_all(run, &pq);
+    
+    pq_destroy(&pq);
+    return result;
+}
+
+
+
+
+
+static int bench_pattern_burst(struct BenchRun_ *run) {
+    
+    PriorityQueue pq;
+    struct BenchSeries_ *pInsert, *pPull;
+    unsigned int burst, index;
+    void *priority, *elem;
+    int result;
+    
+    
+    if (bench_init_queue(run, &pq) != 0)
+        return -1;
+    
+    result = 0;
+    pInsert = run->series + 0;
+    pPull = run->series + 1;
+    bench_series_start(pInsert);
+    bench_series_start(pPull);
+    for (burst = 0; burst < PQ_BENCH_BURSTS && result == 0; burst += 1) {
+        bench_series_resume(pInsert);
+        for (index = 0; index < run->n && result == 0; index += 1) {
+            result = pq_insert_with_priority(&pq, run->pKey + index, run->pKey + index);
+            bench_series_tick(pInsert);
+        }
+        bench_series_lap(pInsert);
+    
+        bench_series_resume(pPull);
+        for (index = 0; index < run->n && result == 0; index += 1) {
+            result = pq_pull_minimum(&pq, &priority, &elem);
+            bench_series_tick(pPull);
+        }
+        bench_series_lap(pPull);
+    }
+    
+    bench_report(run, "insert", pInsert);
+    bench_report(run, "pull_min", pPull);
+    
+    pq_destroy(&pq);
+    return result;
+}
+
+
+
+
+
+/* Hash of a 32-bit value (lowbias32), from which the graph patterns draw their edges */
+static unsigned int bench_hash(unsigned int value) {
+    
+    value ^= value >> 16;
+    value *= 0x7feb352du;
+    value ^= value >> 15;
+    value *= 0x846ca68bu;
+    value ^= value >> 16;
+    return value;
+}
+
+
+
+
+
+/*  Dijkstra's shortest paths (or Prim's spanning tree) over a random graph whose
+    edges are computed, not stored. A vertex enters the queue when it is first
+    reached, and its key is lowered in place through its handle when a shorter
+    path (a lighter edge) is found. One step pulls a vertex and relaxes its edges.
+*/
+static int bench_graph(struct BenchRun_ *run, int isPrim) {
+    
+    PriorityQueue pq;
+    struct BenchSeries_ *pSeries;
+    unsigned char *pDone;
+    unsigned int *pDistance;
+    unsigned int vertex, edge, target, hash, distance;
+    void *priority, *elem;
+    int result;
+    
+    
+    pDone = (unsigned char *) calloc(run->n, 1);
+    if (pDone == 0)
+        return -1;
+    pDistance = run->pAltKey;
+    for (vertex = 0; vertex < run->n; vertex += 1)
+        pDistance[vertex] = ~0u;
+    
+    if (bench_init_queue(run, &pq) != 0) {
+        free((void *) pDone);
+        return -1;
+    }
+    
+    pSeries = run->series + 1;
+    bench_series_start(pSeries);
+    pDistance[0] = 0;
+    result = pq_insert_with_handle(&pq, pDistance + 0, pDistance + 0, run->pHandle + 0);
+    while (result == 0 && pq_size(&pq) != 0) {
+        result = pq_pull_minimum(&pq, &priority, &elem);
+        if (result != 0)
+            break;
+        vertex = (unsigned int) ((unsigned int *) elem - pDistance);
+        pDone[vertex] = 1;
+    
+        for (edge = 0; edge < PQ_BENCH_GRAPH_DEGREE && result == 0; edge += 1) {
+            hash = bench_hash(vertex * PQ_BENCH_GRAPH_DEGREE + edge);
+            target = hash % run->n;
+            distance = 1 + (bench_hash(hash) & 0xFFu);
+            if (isPrim == 0)
+                distance += pDistance[vertex];
+            if (pDone[target] != 0 || distance >= pDistance[target])
+                continue;
+    
+            if (pDistance[target] == ~0u) {
+                pDistance[target] = distance;
+                result = pq_insert_with_handle(&pq, pDistance + target, pDistance + target,
+                                               run->pHandle + target);
+            }
+            else {
+                pDistance[target] = distance;
+                result = pq_reassign_priority_handle(&pq, run->pHandle[target], pDistance + target, 0);
+            }
+        }
+        bench_series_tick(pSeries);
+    }
+    bench_series_lap(pSeries);
+    bench_report(run, "settle", pSeries);
+    
+    pq_destroy(&pq);
+    free((void *) pDone);
+    return result;
+}
+
+
+
+
+
+static int bench_pattern_dijkstra(struct BenchRun_ *run) {
+    
+    return bench_graph(run, 0);
+}
+
+
+
+
+
+static int bench_pattern_prim(struct BenchRun_ *run) {
+    
+    return bench_graph(run, 1);
+}
+
+
+
+
+
+static const struct {
+    const char *name;
+    int (*fpRun) (struct BenchRun_ *run);
+} benchPatterns[] = {
+    { "random",         bench_pattern_random        },
+    { "monotonic",      bench_pattern_monotonic     },
+    { "hold",           bench_pattern_hold          },
+    { "alternating",    bench_pattern_alternating   },
+    { "decrease_key",   bench_pattern_decrease_key  },
+    { "burst",          bench_pattern_burst         },
+    { "dijkstra",       bench_pattern_dijkstra      },
+    { "prim",           bench_pattern_prim          }
+};
+
+
+
+
+
+static int bench_size(unsigned int n, int format, const char *engineFilter, const char *patternFilter) {
+    
+    struct BenchRun_ run;
+    unsigned int index, state, e, p;
+    int result;
+    
+    
+    run.n = n;
+    run.format = format;
+    run.pKey = (unsigned int *) malloc((size_t) n * sizeof(unsigned int));
+    run.pAltKey = (unsigned int *) malloc((size_t) n * sizeof(unsigned int));
+    run.pHandle = (PQhandle *) malloc((size_t) n * sizeof(PQhandle));
+    run.series[0].sampleCapacity = (size_t) PQ_BENCH_BURSTS * n / PQ_BENCH_BATCH + PQ_BENCH_BURSTS + 1;
+    run.series[1].sampleCapacity = run.series[0].sampleCapacity;
+    run.series[0].pSample = (double *) malloc(run.series[0].sampleCapacity * sizeof(double));
+    run.series[1].pSample = (double *) malloc(run.series[1].sampleCapacity * sizeof(double));
+    
+    result = -1;
+    if (run.pKey == 0 || run.pAltKey == 0 || run.pHandle == 0 ||
+        run.series[0].pSample == 0 || run.series[1].pSample == 0) {
+        fprintf(stderr, "out of memory\n");
+        goto SIZE_END;
+    }
+    
+    /* xorshift32, the same key sequence for every engine */
+    state = 2463534242u;
+    for (index = 0; index < n; index += 1) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        run.pKey[index] = state;
+    }
+    
+    for (e = 0; e < sizeof(benchEngines) / sizeof(benchEngines[0]); e += 1) {
+        if (engineFilter != 0 && strcmp(engineFilter, benchEngines[e].name) != 0)
+            continue;
+        run.engine = benchEngines[e].engine;
+        run.engineName = benchEngines[e].name;
+    
+        for (p = 0; p < sizeof(benchPatterns) / sizeof(benchPatterns[0]); p += 1) {
+            if (patternFilter != 0 && strcmp(patternFilter, benchPatterns[p].name) != 0)
+                continue;
+            run.patternName = benchPatterns[p].name;
+            if (benchPatterns[p].fpRun(&run) != 0) {
+                fprintf(stderr, "%s engine failed the %s pattern\n", run.engineName, run.patternName);
+                goto SIZE_END;
+            }
+            fflush(stdout);
+        }
+    }
+    result = 0;
+    
+    
+    SIZE_END:
+    free((void *) run.pKey);
+    free((void *) run.pAltKey);
+    free((void *) run.pHandle);
+    free((void *) run.series[0].pSample);
+    free((void *) run.series[1].pSample);
+    return result;
+}
+
+
+
+
+
+int main(int argc, char **argv) {
+    
+    static const unsigned int defaultSizes[] = { 1000u, 10000u, 100000u, 1000000u };
+    const char *engineFilter, *patternFilter;
+    unsigned int sizes[64];
+    unsigned int sizeCount, index;
+    unsigned long n;
+    int arg, format;
+    
+    
+    format = PQ_BENCH_FORMAT_TABLE;
+    engineFilter = 0;
+    patternFilter = 0;
+    sizeCount = 0;
+    for (arg = 1; arg < argc; arg += 1) {
+        if (strcmp(argv[arg], "--format=table") == 0)
+            format = PQ_BENCH_FORMAT_TABLE;
+        else if (strcmp(argv[arg], "--format=csv") == 0)
+            format = PQ_BENCH_FORMAT_CSV;
+        else if (strcmp(argv[arg], "--format=json") == 0)
+            format = PQ_BENCH_FORMAT_JSON;
+        else if (strncmp(argv[arg], "--engine=", 9) == 0)
+            engineFilter = argv[arg] + 9;
+        else if (strncmp(argv[arg], "--pattern=", 10) == 0)
+            patternFilter = argv[arg] + 10;
+        else {
+            n = strtoul(argv[arg], 0, 10);
+            if (n == 0 || n > PQ_BENCH_MAXIMUM_SIZE || sizeCount == sizeof(sizes) / sizeof(sizes[0])) {
+                fprintf(stderr, "usage: %s [--format=table|csv|json] [--engine=NAME] "
+                                "[--pattern=NAME] [n ...]\n", argv[0]);
+                return 1;
+            }
+            sizes[sizeCount] = (unsigned int) n;
+            sizeCount += 1;
+        }
+    }
+    if (sizeCount == 0) {
+        for (index = 0; index < sizeof(defaultSizes) / sizeof(defaultSizes[0]); index += 1)
+            sizes[index] = defaultSizes[index];
+        sizeCount = index;
+    }
+    
+    if (format == PQ_BENCH_FORMAT_CSV)
+        printf("engine,pattern,operation,elements,operations,ops_per_sec,"
+               "ns_p50,ns_p90,ns_p99,ns_max,peak_bytes\n");
+    else if (format == PQ_BENCH_FORMAT_TABLE)
+        printf("%-8s %-13s %-16s %10s %12s %9s %9s %9s %11s %10s\n", "engine", "pattern", "operation",
+                    "elements", "Mops/s", "p50 ns", "p90 ns", "p99 ns", "max ns", "peak MiB");
+    
+    for (index = 0; index < sizeCount; index += 1) {
+        if (bench_size(sizes[index], format, engineFilter, patternFilter) != 0)
+            return 1;
+    }
+    
+    return 0;
+}
+
@@ -0,0 +1,271 @@
+
+
+/************************************************************************************
+    Scaling benchmark of the thread safe Double Ended Priority Queue ADT
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+/*
+ *  Every thread alternates between inserting a random key and pulling the
+ *  minimum of a shared queue, which is prefilled so that it never runs empty.
+ *  The same workload runs over a PriorityQueue behind one global mutex, over
+ *  a flat combining PQconcurrent and over a relaxed PQrelaxed (two heaps per
+ *  thread), with 1, 2, 4 ... up to the given thread count. The relaxed queue
+ *  also reports the mean rank error of its pulls.
+ *
+ *  Build:
+ *      gcc -std=c99 -O2 -DNDEBUG -pthread -Iinclude src/pq_*.c bench/pq_concurrent_bench.c -o pq_concurrent_bench
+ *
+ *  Usage:
+ *      ./pq_concurrent_bench [threads] [operations per thread]
+ *                                  (default: online processors, 200000)
+*/
+
+
+
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "pq.h"
+#include "pq_concurrent.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+
+
+
+
+#define PQ_BENCH_PREFILL                100000u
+#define PQ_BENCH_KEY_SPACE              (1u << 20)
+#define PQ_BENCH_RANK_SAMPLING          16384u
+
+
+#define PQ_BENCH_MUTEX                  0
+#define PQ_BENCH_COMBINING              1
+#define PQ_BENCH_RELAXED                2
+
+
+
+
+struct BenchContext_ {
+    
+    PriorityQueue *pq;                      /* Queue of the global mutex variant */
+    pthread_mutex_t *pLock;
+    PQconcurrent *cq;                       /* Queue of the flat combining variant */
+    PQrelaxed *rq;                          /* Queue of the relaxed variant */
+    unsigned int *pKeys;                    /* Keys inserted by this thread */
+    unsigned int operations;
+    pthread_barrier_t *pStart;
+};
+
+
+
+
+static int bench_compare(const void *a, const void *b) {
+    
+    unsigned int x, y;
+    
+    
+    x = *((const unsigned int *) a);
+    y = *((const unsigned int *) b);
+    return x < y ? -1 : x > y ? 1 : 0;
+}
+
+
+
+
+
+static double bench_seconds(void) {
+    
+    struct timespec ts;
+    
+    
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double) ts.tv_sec + (double) ts.tv_nsec * 1e-9;
+}
+
+
+
+
+
+static void *bench_worker(void *arg) {
+    
+    struct BenchContext_ *ctx;
+    unsigned int index;
+    void *priority, *elem;
+    
+    
+    ctx = (struct BenchContext_ *) arg;
+    pthread_barrier_wait(ctx->pStart);
+    
+    for (index = 0; index < ctx->operations; index += 2) {
+        if (ctx->cq != 0) {
+            pq_concurrent_insert_with_priority(ctx->cq, ctx->pKeys + index, ctx->pKeys + index);
+            pq_concurrent_pull_minimum(ctx->cq, &priority, &elem);
+        }
+        else if (ctx->rq != 0) {
+            pq_relaxed_insert_with_priority(ctx->rq, ctx->pKeys + index, ctx->pKeys + index);
+            pq_relaxed_pull_minimum(ctx->rq, &priority, &elem);
+        }
+        else {
+            pthread_mutex_lock(ctx->pLock);
+            pq_insert_with_priority(ctx->pq, ctx->pKeys + index, ctx->pKeys + index);
+            pq_pull_minimum(ctx->pq, &priority, &elem);
+            pthread_mutex_unlock(ctx->pLock);
+        }
+    }
+    
+    return 0;
+}
+
+
+
+
+
+static double bench_run(int variant, unsigned int threads, unsigned int operations,
+                        unsigned int *pKeys, unsigned int *pPrefill, double *pRankError) {
+    
+    PriorityQueue pq;
+    PQconcurrent cq;
+    PQrelaxed rq;
+    PQrelaxedStats stats;
+    pthread_mutex_t lock;
+    pthread_barrier_t start;
+    pthread_t *pThreads;
+    struct BenchContext_ *pContexts;
+    unsigned int index;
+    double begin, elapsed;
+    
+    
+    pThreads = (pthread_t *) malloc(threads * sizeof(pthread_t));
+    pContexts = (struct BenchContext_ *) malloc(threads * sizeof(struct BenchContext_));
+    if (pThreads == 0 || pContexts == 0)
+        return -1.0;
+    
+    pthread_mutex_init(&lock, 0);
+    pthread_barrier_init(&start, 0, threads + 1);
+    if (variant == PQ_BENCH_COMBINING) {
+        pq_concurrent_init(&cq, PQ_ENGINE_BINARY_HEAP, PQ_HEAP_MIN, PQ_BENCH_PREFILL * 2,
+                            threads, bench_compare, 0, 0);
+        for (index = 0; index < PQ_BENCH_PREFILL; index += 1)
+            pq_concurrent_insert_with_priority(&cq, pPrefill + index, pPrefill + index);
+    }
+    else if (variant == PQ_BENCH_RELAXED) {
+        pq_relaxed_init(&rq, threads * 2, 0, PQ_BENCH_PREFILL * 2, bench_compare, 0, 0);
+        for (index = 0; index < PQ_BENCH_PREFILL; index += 1)
+            pq_relaxed_insert_with_priority(&rq, pPrefill + index, pPrefill + index);
+        pq_relaxed_set_rank_sampling(&rq, PQ_BENCH_RANK_SAMPLING);
+    }
+    else {
+        pq_init(&pq, PQ_HEAP_MIN, PQ_BENCH_PREFILL * 2, bench_compare, 0, 0);
+        for (index = 0; index < PQ_BENCH_PREFILL; index += 1)
+            pq_insert_with_priority(&pq, pPrefill + index, pPrefill + index);
+    }
+    
+    for (index = 0; index < threads; index += 1) {
+        pContexts[index].pq = &pq;
+        pContexts[index].pLock = &lock;
+        pContexts[index].cq = variant == PQ_BENCH_COMBINING ? &cq : 0;
+        pContexts[index].rq = variant == PQ_BENCH_RELAXED ? &rq : 0;
+        pContexts[index].pKeys = pKeys + (size_t) index * operations;
+        pContexts[index].operations = operations;
+        pContexts[index].pStart = &start;
+        pthread_create(pThreads + index, 0, bench_worker, (void *) (pContexts + index));
+    }
+    
+    pthread_barrier_wait(&start);
+    begin = bench_seconds();
+    for (index = 0; index < threads; index += 1)
+        pthread_join(pThreads[index], 0);
+    elapsed = bench_seconds() - begin;
+    
+    if (variant == PQ_BENCH_COMBINING) {
+        pq_concurrent_destroy(&cq);
+    }
+    else if (variant == PQ_BENCH_RELAXED) {
+        pq_relaxed_get_stats(&rq, &stats);
+        *pRankError = stats.sampleCount != 0 ? (double) stats.rankErrorSum / stats.sampleCount : 0.0;
+        pq_relaxed_destroy(&rq);
+    }
+    else
+        pq_destroy(&pq);
+    pthread_barrier_destroy(&start);
+    pthread_mutex_destroy(&lock);
+    free((void *) pThreads);
+    free((void *) pContexts);
+    
+    return (double) threads * operations / elapsed * 1e-6;
+}
+
+
+
+
+
+int main(int argc, char **argv) {
+    
+    unsigned int maxThreads, operations, threads;
+    unsigned int index, state;
+    unsigned int *pKeys, *pPrefill;
+    double mutexRate, combiningRate, relaxedRate, rankError;
+    long processors;
+    
+    
+    processors = sysconf(_SC_NPROCESSORS_ONLN);
+    maxThreads = argc > 1 ? (unsigned int) strtoul(argv[1], 0, 10) :
+                    (processors > 0 ? (unsigned int) processors : 1);
+    operations = argc > 2 ? (unsigned int) strtoul(argv[2], 0, 10) : 200000;
+    operations += operations & 1;
+    if (maxThreads == 0 || operations == 0) {
+        fprintf(stderr, "usage: %s [threads] [operations per thread]\n", argv[0]);
+        return 1;
+    }
+    
+    pKeys = (unsigned int *) malloc((size_t) maxThreads * operations * sizeof(unsigned int));
+    pPrefill = (unsigned int *) malloc(PQ_BENCH_PREFILL * sizeof(unsigned int));
+    if (pKeys == 0 || pPrefill == 0) {
+        fprintf(stderr, "out of memory\n");
+        return 1;
+    }
+    
+    /* xorshift32 */
+    state = 2463534242u;
+    for (index = 0; index < PQ_BENCH_PREFILL; index += 1) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        pPrefill[index] = state % PQ_BENCH_KEY_SPACE;
+    }
+    for (index = 0; index < maxThreads * operations; index += 1) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        pKeys[index] = state % PQ_BENCH_KEY_SPACE;
+    }
+    
+    printf("%8s %16s %16s %16s %12s\n", "threads", "mutex Mops/s", "combining Mops/s",
+                "relaxed Mops/s", "rank error");
+    /* Powers of two, then the requested count itself */
+    threads = 1;
+    while (1) {
+        rankError = 0.0;
+        mutexRate = bench_run(PQ_BENCH_MUTEX, threads, operations, pKeys, pPrefill, &rankError);
+        combiningRate = bench_run(PQ_BENCH_COMBINING, threads, operations, pKeys, pPrefill, &rankError);
+        relaxedRate = bench_run(PQ_BENCH_RELAXED, threads, operations, pKeys, pPrefill, &rankError);
+        printf("%8u %16.2f %16.2f %16.2f %12.2f\n", threads,
+                    mutexRate, combiningRate, relaxedRate, rankError);
+        if (threads == maxThreads)
+            break;
+        threads = threads * 2 < maxThreads ? threads * 2 : maxThreads;
+    }
+    
+    free((void *) pKeys);
+    free((void *) pPrefill);
+    return 0;
+}
+
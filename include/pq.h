@@ -1,387 +1,1318 @@
-
-
-/************************************************************************************
-    Public Program Interface of Double Ended Priority Queue ADT
-    Based on Binary Heap Data Structure (Array Based)
-    Author:             Ashis Kumar Das
-    Email:              akd.bracu@gmail.com
-    GitHub:             https://github.com/AKD92
-*************************************************************************************/
-
-
-
-
-
-
-#ifndef DOUBLE_ENDED_PQ_BIHEAP_H
-#define DOUBLE_ENDED_PQ_BIHEAP_H
-
-
-
-
-
-
-
-
-/*********************************************************************************************/
-/***********************************                      ************************************/
-/***********************************    DATA STRUCTURES   ************************************/
-/***********************************                      ************************************/
-/*********************************************************************************************/
-
-
-
-
-enum PQ_HeapOrient_t {
-    
-    PQ_HEAP_MIN = 0,
-    PQ_HEAP_MAX = 1,
-    
-};
-
-
-struct PQnode_ {
-    
-    void *priority;                         /* Pointer to the priority element */
-    void *elem;                             /* Pointer to the element */
-    
-    int (*fpComparePriority)                /* User specifed function for comparing two priority elements */
-            (const void *pr1, const void *pr2);
-            
-};
-typedef struct PQnode_ PQnode;
-
-
-struct PriorityQueue_DE_ {
-    
-    PQnode *pArrayNode;                     /* Array of PQnode objects, which will carry user keys & data */
-                                            /* The operations of a PQ like removeMin(), removeMAX(), insert() */
-                                            /* Will eventually manipulate this array using HEAP algorithms */
-    
-    enum PQ_HeapOrient_t heapOrint;         /* Current state of Heap Orientation: PQ_HEAP_MIN or PQ_HEAP_MAX */
-    
-    unsigned int nodeCount;                 /* Number of objects in the PQnode array (not array length) */
-    unsigned int arrCapacity;               /* Length of PQnode array */
-    
-    int     (*fpComparePriority)    (const void *key1, const void *key2);
-    void    (*fpDestroyPriority)    (void *priority);
-    void    (*fpDestroyElement)     (void *element);
-    
-};
-typedef struct PriorityQueue_DE_ PriorityQueue;
-
-
-
-
-
-
-/*********************************************************************************************/
-/***********************************                      ************************************/
-/***********************************   PUBLIC INTERFACES  ************************************/
-/***********************************                      ************************************/
-/*********************************************************************************************/
-
-
-
-/*
- *  Returns the underlying array of PQnode of the current priority queue.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *
- *  Returns:
- *      (PQnode *)		Pointer to the internal array of type PQnode *
-*/
-#define pq_array(pq)                         ((pq)->pArrayNode)
-
-
-
-
-
-/*
- *  Returns the number of elements the priority queue is currently holding.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *
- *  Returns:
- *      (unsigned int)	Number of current elements
-*/
-#define pq_size(pq)                          ((pq)->nodeCount)
-
-
-
-
-
-/*
- *  Returns the capacity (total number of slots) of the specified priority queue.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *
- *  Returns:
- *      (unsigned int)	Capacity of the specified priority queue
-*/
-#define pq_capacity(pq)                      ((pq)->arrCapacity)
-
-
-
-
-
-/*
- *  Returns the heap orientation (min queue or max queue) of the 
- *	specified priority queue.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *
- *  Returns:
- *      (enum PQ_HeapOrient_t)	Heap orientation of the specified priority queue
-*/
-#define pq_heap_orientation(pq)               ((pq)->heapOrint)
-
-
-
-
-
-/*
- *  Initializes the given priority queue.
- *
- *  Parameter:
- *      pq       	        :   Pointer to a priority queue to initialize
- *		hOrientation        :	Orientation of the binary heap (min queue or max queue)
- *      capacity            :   Total number of elements this priority queue is able to hold
- *                              If the capacity becomes full at some point, the priority queue
- *                              will allocate additional memory and increase this capacity
- *                              by double.
- *		fpComparePriority   :	Pointer to the function which will compare the priority elements
- *						        of the priority queue
- *                              (can not be NULL)
- *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
- *						        of the priority queue
- *                              (can be NULL)
- *		fpDestroyElement    :	Pointer to the function which will destroy the elements
- *						        (can be NULL)
- *
- *  Returns:
- *      (int)			(success) 0 if the priority queue is initialized successfully
- *						(failure) -1 if any of the supplied parameters is NULL
- *                      (failure) -2 if failed to allocate memory
-*/
-int pq_init(
-    PriorityQueue *pq,
-    enum PQ_HeapOrient_t hOrientation,
-    unsigned int capacity,
-    int (*fpComparePriority) (const void *pr1, const void *pr2),
-    void (*fpDestroyPriority) (void *priority),
-    void (*fpDestroyElement) (void *element)
-);
-
-
-
-
-
-/*
- *  Destroys the given priority queue.
- *	Releases all the resources occupied by the queue.
- *	if fpDestroyPriority or fpDestroyElement functions are provided,
- *	then those functions are called for each priority element and each element
- *	to destroy all the containing elements along with their priority elements.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue to destroy
- *
- *  Returns:
- *      (void)
-*/
-void pq_destroy(PriorityQueue *pq);
-
-
-
-
-
-/*
- *  Insets an element with a priority associated into the specified priority queue.
- *  Both the priority and the elem can point to the same element/object in memory
- *  at the same time and can not be NULL.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *		elem		:	Pointer to the element which is being inserted with the priority
- *                      (can not be NULL)
- *		priority	:	Pointer to the priority element which is the priority of elem element
- *                      (can not be NULL)
- *
- *  Returns:
- *      (int)			(success) 0 if the elem is successfully inserted
- *						(failure) -1 if the supplied parameters are invalid
- *                      (failure) -2 if the queue is full and additional memory is not available
-*/
-int pq_insert_with_priority(PriorityQueue *pq, const void *elem, const void *priority);
-
-
-
-
-
-/*
- *  Retrives but does not remove the element with minimum priority from the priority queue.
- *	The element with minimum priority will be determined by the compare
- *	function (fpComparePriority) provided with the priority queue.
- *  If the heap orientation of the specified priority queue is PQ_HEAP_MIN
- *  then this operation will commit in O(1) time.
- *  Otherwise, in case if the heap orientation is PQ_HEAP_MAX,
- *  then it will be transformed into a PQ_HEAP_MIN type before obtaining
- *  the element with minimum priority and this operation will commit in O(nlogn) time,
- *  where n = Number of element on the priority queue.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *		priority	:	Pointer to a pointer which will receive the priority
- *						(can not be NULL)
- *		elem		:	Pointer to a pointer which will receive the minimum element
- *						(can not be NULL)
- *
- *  Returns:
- *      (int)			(success) 0 if the minimum key is retrived
- *						(failure) -1 otherwise (the queue is empty or pq is NULL)
-*/
-int pq_peek_minimum(PriorityQueue *pq, void **priority, void **elem);
-
-
-
-
-
-/*
- *  Retrives but does not remove the element with maximum priority from the priority queue.
- *	The element with maximum priority will be determined by the compare
- *	function (fpComparePriority) provided with the priority queue.
- *  If the heap orientation of the specified priority queue is PQ_HEAP_MAX
- *  then this operation will commit in O(1) time.
- *  Otherwise, in case if the heap orientation is PQ_HEAP_MIN,
- *  then it will be transformed into a PQ_HEAP_MAX type before obtaining
- *  the element with maximum priority and this operation will commit in O(nlogn) time,
- *  where n = Number of element on the priority queue.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *		priority	:	Pointer to a pointer which will receive the priority
- *						(can not be NULL)
- *		elem		:	Pointer to a pointer which will receive the maximum element
- *						(can not be NULL)
- *
- *  Returns:
- *      (int)			(success) 0 if the maximum key is retrived
- *						(failure) -1 otherwise (the queue is empty or pq is NULL)
-*/
-int pq_peek_maximum(PriorityQueue *pq, void **priority, void **elem);
-
-
-
-
-
-/*
- *  Retrives and removes the element with minimum priority from the priority queue.
- *	The element with minimum priority will be determined by the compare
- *	function (fpComparePriority) provided with the priority queue.
- *  If the heap orientation of the specified priority queue is PQ_HEAP_MIN
- *  then this operation will commit in O(1) time.
- *  Otherwise, in case if the heap orientation is PQ_HEAP_MAX,
- *  then it will be transformed into a PQ_HEAP_MIN type before obtaining
- *  the element with minimum priority and this operation will commit in O(nlogn) time,
- *  where n = Number of element on the priority queue.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *		priority	:	Pointer to a pointer which will receive the priority
- *						(can not be NULL)
- *		elem		:	Pointer to a pointer which will receive the minimum element
- *						(can not be NULL)
- *
- *  Returns:
- *      (int)			(success) 0 if the minimum key is retrived and removed
- *						(failure) -1 otherwise (the queue is empty or pq is NULL)
-*/
-int pq_pull_minimum(PriorityQueue *pq, void **priority, void **elem);
-
-
-
-
-
-/*
- *  Retrives and removes the element with maximum priority from the priority queue.
- *	The element with maximum priority will be determined by the compare
- *	function (fpComparePriority) provided with the priority queue.
- *  If the heap orientation of the specified priority queue is PQ_HEAP_MAX
- *  then this operation will commit in O(1) time.
- *  Otherwise, in case if the heap orientation is PQ_HEAP_MIN,
- *  then it will be transformed into a PQ_HEAP_MAX type before obtaining
- *  the element with maximum priority and this operation will commit in O(nlogn) time,
- *  where n = Number of element on the priority queue.
- *
- *  Parameter:
- *      pq       	:   Pointer to a priority queue
- *		priority	:	Pointer to a pointer which will receive the priority
- *						(can not be NULL)
- *		elem		:	Pointer to a pointer which will receive the maximum element
- *						(can not be NULL)
- *
- *  Returns:
- *      (int)			(success) 0 if the maximum key is retrived and removed
- *						(failure) -1 otherwise (the queue is empty or pq is NULL)
-*/
-int pq_pull_maximum(PriorityQueue *pq, void **priority, void **elem);
-
-
-
-
-
-/*
- *  Reassign (change) the priority associated to an existing element in the priority queue.
- *  This is an O(n) time operation, where n is the number of elements this queue is holding.
- *
- *  Parameter:
- *      pq              :   Pointer to a priority queue
- *      fpCompareElement:   Pointer to a function which will be used to identify
- *                          the location of the element (elem) by comparing this element (elem)
- *                          with the elements exist in this priority queue
- *                          (can not be NULL).
- *                          At least the equality comparison is required from this
- *                          comparison function, such that it will return 0 when
- *                          two elements are considered equal.
- *                          It is fine if this comparison function implements 'total order'.
- *      elem            :   Pointer to an element which must exists into the specified
- *                          priority queue. It is vital that it must exists because
- *                          the priority associated with it is being changed
- *                          (can not be NULL).
- *      priority        :   Pointer to a priority element which is being assigned as the new
- *                          priority of the (elem) element
- *                          (can not be NULL).
- *                          Just like the requirements of the 'insert' function, this
- *                          priority element and the elem element can be same. In other
- *                          words, they can point to the same element/object in memory
- *                          at the same time.
- *      oldPriority     :   Pointer to a pointer which will receive the memory location of
- *                          the old priority element which is being replaced by the new
- *                          priority element.
- *                          (can be NULL)
- *
- *  Returns:
- *      (int)			(success) 0 if the priority is successfully reassigned
- *						(failure) -1 if the supplied parameters are invalid
- *                      (failure) -2 if the specified element does not exist on the queue
-*/
-int pq_reassign_priority(
-    PriorityQueue *pq,
-    int (*fpCompareElement) (const void *arg1, const void *arg2),
-    const void *elem,
-    const void *priority,
-    void **oldPriority
-);
-
-
-
-
-
-#endif
-
-
+
+
+/************************************************************************************
+    Public Program Interface of Double Ended Priority Queue ADT
+    Based on Binary Heap Data Structure (Array Based)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef DOUBLE_ENDED_PQ_BIHEAP_H
+#define DOUBLE_ENDED_PQ_BIHEAP_H
+
+
+
+
+#include <stddef.h>
+
+
+
+
+
+
+
+
+/*********************************************************************************************/
+/***********************************                      ************************************/
+/***********************************    DATA STRUCTURES   ************************************/
+/***********************************                      ************************************/
+/*********************************************************************************************/
+
+
+
+
+enum PQ_HeapOrient_t {
+    
+    PQ_HEAP_MIN = 0,
+    PQ_HEAP_MAX = 1,
+    
+};
+
+
+enum PQ_Engine_t {
+    
+    PQ_ENGINE_BINARY_HEAP = 0,              /* Single binary heap, re-oriented (rebuilt) on demand */
+    PQ_ENGINE_MINMAX_HEAP = 1,              /* Min-Max heap, both extremes are always reachable */
+    PQ_ENGINE_DARY4_HEAP  = 2,              /* Like the binary heap, but every node has 4 children */
+    PQ_ENGINE_DARY8_HEAP  = 3,              /* Like the binary heap, but every node has 8 children */
+    PQ_ENGINE_RADIX_HEAP  = 4,              /* Monotone radix heap of integer keys, see pq_init_radix() */
+    PQ_ENGINE_PAIRING_HEAP = 5,             /* Pairing heap of linked nodes, O(1) insert & priority decrease */
+    
+};
+
+
+struct PQnode_ {
+    
+    void *priority;                         /* Pointer to the priority element */
+    void *elem;                             /* Pointer to the element */
+                                            /* The compare function is held once by the PriorityQueue */
+};
+typedef struct PQnode_ PQnode;
+
+
+typedef unsigned int PQhandle;              /* Stable identifier of a node, valid until the node leaves the queue */
+#define PQ_HANDLE_NONE                      ((PQhandle) ~0u)
+
+
+#define PQ_CAPACITY_MAX                     0xFFFFFFFEu         /* Largest capacity, indices & handles are unsigned int */
+#define PQ_CACHE_LINE_SIZE                  64                  /* Alignment of the node arrays & of shared counters */
+#define PQ_DEFAULT_GROWTH_PERCENT           200                 /* A full array grows to 200% of its capacity */
+#define PQ_DEFAULT_SHRINK_PERCENT           25                  /* An array less than 25% full shrinks */
+
+
+struct PQallocator_ {
+    
+    void *  (*fpAlloc)      (void *context, size_t size);
+    void *  (*fpRealloc)    (void *context, void *block, size_t oldSize, size_t newSize);
+    void    (*fpFree)       (void *context, void *block, size_t size);
+    void *context;                          /* Passed unchanged to every function above */
+                                            /* The size of a block is passed back on realloc & free */
+};
+typedef struct PQallocator_ PQallocator;
+
+
+struct PQarena_ {
+    
+    struct PQarenaChunk_ *pChunk;           /* Most recent chunk, the chunks are chained backwards */
+    size_t chunkSize;                       /* Minimum size of a new chunk in bytes */
+};
+typedef struct PQarena_ PQarena;
+
+
+/*
+ *  Counters of the work done inside a queue. Only rebuilds and leafScans are
+ *  always counted, the others are counted when the library is compiled with
+ *  PQ_ENABLE_STATS defined (the code which counts them is left out otherwise).
+ *  Every PriorityQueue has the counters either way, so its layout is the same
+ *  whether the library has been compiled with PQ_ENABLE_STATS or not.
+*/
+struct PQstats_ {
+    
+    unsigned long long comparisons;         /* Calls of the priority compare function */
+    unsigned long long nodeMoves;           /* Nodes moved one step by swims & sinks (the sift steps) */
+    unsigned long long rebuilds;            /* Whole heap rebuilds due to a Heap Orientation mismatch */
+    unsigned long long leafScans;           /* Scans of the leaves for the opposite extreme */
+    unsigned long long expansions;          /* Growths of the PQnode array */
+    unsigned long long shrinks;             /* Reductions of the PQnode array */
+    unsigned long long bytesCopied;         /* Bytes copied because a resized array had to move */
+    unsigned long long reassignScans;       /* Calls of pq_reassign_priority(), which scan the array */
+    unsigned long long reassignScanLength;  /* Nodes visited by those scans in total */
+    unsigned long long reassignScanMax;     /* Nodes visited by the longest of those scans */
+};
+typedef struct PQstats_ PQstats;
+
+
+/*
+ *  Converts the priorities and the elements to bytes for pq_snapshot_save() and
+ *  back for pq_snapshot_load(). A save function writes the bytes of the object
+ *  into buffer if they fit into size bytes and returns their number either way
+ *  (it is called again with a larger buffer), or returns (size_t) -1 on failure.
+ *  A load function returns a new object made of size bytes (aligned to 8 bytes),
+ *  or NULL on failure.
+ *
+ *  Flat objects (integers, doubles, plain structs) need no functions: when
+ *  priorityBytes (elementBytes) is not 0, the objects are saved as they are, and
+ *  restored in place from a private copy-on-write mapping of the snapshot file,
+ *  which the queue keeps until pq_destroy(). The queue must not destroy them then.
+*/
+struct PQserializer_ {
+    
+    size_t  (*fpSavePriority)   (void *context, const void *priority, void *buffer, size_t size);
+    size_t  (*fpSaveElement)    (void *context, const void *element, void *buffer, size_t size);
+    void *  (*fpLoadPriority)   (void *context, const void *data, size_t size);
+    void *  (*fpLoadElement)    (void *context, const void *data, size_t size);
+    size_t priorityBytes;                   /* Size of a flat priority saved as it is, or 0 */
+    size_t elementBytes;                    /* Size of a flat element saved as it is, or 0 */
+    void *context;                          /* Passed unchanged to every function above */
+};
+typedef struct PQserializer_ PQserializer;
+
+
+struct PriorityQueue_DE_ {
+    
+    PQnode *pArrayNode;                     /* Array of PQnode objects, which will carry user keys & data */
+                                            /* The operations of a PQ like removeMin(), removeMAX(), insert() */
+                                            /* Will eventually manipulate this array using HEAP algorithms */
+    void *pArrayBlock;                      /* Memory block which holds pArrayNode (they differ when the */
+                                            /* d-ary heap engines align the child groups to cache lines) */
+    
+    enum PQ_HeapOrient_t heapOrint;         /* Current state of Heap Orientation: PQ_HEAP_MIN or PQ_HEAP_MAX */
+    enum PQ_Engine_t heapEngine;            /* Storage engine which maintains the PQnode array */
+    unsigned int heapArityShift;            /* Number of children of every node is (1 << heapArityShift) */
+    
+    unsigned int oppositeIndex;             /* Index of the extreme opposite to the Heap Orientation, */
+                                            /* or ~0u while it is not known (binary & d-ary heap engines) */
+    unsigned int oppositePulls;             /* Pulls from the opposite extreme since the last re-orientation */
+    unsigned long rebuildCount;             /* Number of re-orientations (whole heap rebuilds) so far */
+    unsigned long leafScanCount;            /* Number of leaf scans which located the opposite extreme */
+    
+    unsigned int nodeCount;                 /* Number of objects in the PQnode array (not array length) */
+    unsigned int arrCapacity;               /* Length of PQnode array */
+    unsigned int minCapacity;               /* Automatic shrinking never goes below this length */
+    unsigned int shrinkBelow;               /* The array shrinks when nodeCount drops below this (0: never) */
+    unsigned int growthPercent;             /* A full array grows to this percent of its length */
+    unsigned int shrinkPercent;             /* Fill percent under which the array shrinks (0: never) */
+    
+    unsigned int *pNodeHandle;              /* Handle of every PQnode (parallel to pArrayNode), or PQ_HANDLE_NONE */
+    unsigned int nodeHandleCapacity;        /* Length of pNodeHandle array (at least arrCapacity) */
+    unsigned int *pHandleIndex;             /* Index in pArrayNode of every handle, or the next free handle */
+    unsigned int handleCapacity;            /* Length of pHandleIndex array */
+    unsigned int handleCount;               /* Number of handles which have ever been issued */
+    unsigned int handleFree;                /* First free (released) handle, or PQ_HANDLE_NONE */
+                                            /* Both arrays are NULL until the first handle is requested */
+    
+    unsigned int *pRadixStart;              /* First index of every bucket (radix heap engine), or NULL */
+    unsigned long long radixLast;           /* Key of the minimum last pulled or peeked from the radix heap */
+    
+    struct PQpairLink_ *pPairLink;          /* Tree links of every node (pairing heap engine, parallel to */
+                                            /* pArrayNode), or NULL */
+    unsigned int pairLinkCapacity;          /* Length of pPairLink array (at least arrCapacity) */
+    unsigned int pairRoot;                  /* Index of the root of the pairing heap, or ~0u if it is empty */
+    
+    void *pSnapshotMap;                     /* Mapping of the snapshot whose flat objects the queue holds, */
+    size_t snapshotMapSize;                 /* Or NULL (see pq_snapshot_load()) */
+    
+    PQallocator allocator;                  /* Source of all the memory owned by this queue */
+    
+    PQstats stats;                          /* Counters of the hot paths, see pq_stats_get() */
+    
+    int     (*fpComparePriority)    (const void *key1, const void *key2);
+    void    (*fpDestroyPriority)    (void *priority);
+    void    (*fpDestroyElement)     (void *element);
+    unsigned long long (*fpPriorityKey) (const void *priority);
+    
+};
+typedef struct PriorityQueue_DE_ PriorityQueue;
+
+
+
+
+
+
+/*********************************************************************************************/
+/***********************************                      ************************************/
+/***********************************   PUBLIC INTERFACES  ************************************/
+/***********************************                      ************************************/
+/*********************************************************************************************/
+
+
+
+/*
+ *  Returns the underlying array of PQnode of the current priority queue.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (PQnode *)		Pointer to the internal array of type PQnode *
+*/
+#define pq_array(pq)                         ((pq)->pArrayNode)
+
+
+
+
+
+/*
+ *  Returns the number of elements the priority queue is currently holding.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (unsigned int)	Number of current elements
+*/
+#define pq_size(pq)                          ((pq)->nodeCount)
+
+
+
+
+
+/*
+ *  Returns the capacity (total number of slots) of the specified priority queue.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (unsigned int)	Capacity of the specified priority queue
+*/
+#define pq_capacity(pq)                      ((pq)->arrCapacity)
+
+
+
+
+
+/*
+ *  Returns the heap orientation (min queue or max queue) of the 
+ *	specified priority queue.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (enum PQ_HeapOrient_t)	Heap orientation of the specified priority queue
+*/
+#define pq_heap_orientation(pq)               ((pq)->heapOrint)
+
+
+
+
+
+/*
+ *  Returns the storage engine (binary heap or min-max heap) of the
+ *	specified priority queue.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (enum PQ_Engine_t)	Storage engine of the specified priority queue
+*/
+#define pq_engine(pq)                         ((pq)->heapEngine)
+
+
+
+
+
+
+/*
+ *  Returns the number of children of every node of the specified priority queue
+ *	(2 for the binary heap and the min-max heap, 4 or 8 for the d-ary heaps).
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (unsigned int)	Arity of the heap
+*/
+#define pq_heap_arity(pq)                     (1u << (pq)->heapArityShift)
+
+
+
+
+
+/*
+ *  Returns how many times the heap of the specified priority queue has been
+ *	re-oriented, that is rebuilt as a whole towards the opposite extreme
+ *	(binary and d-ary heap engines; the pairing heap engine counts every time
+ *	it pairs all of its nodes again towards the other extreme). The fallback
+ *	of a radix heap to a binary heap counts as a rebuild as well. Always 0 for
+ *	the min-max heap.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (unsigned long)	Number of heap rebuilds
+*/
+#define pq_rebuild_count(pq)                  ((pq)->rebuildCount)
+
+
+
+
+
+/*
+ *  Returns how many times the leaves of the heap of the specified priority
+ *	queue have been scanned to locate the extreme opposite to its orientation.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (unsigned long)	Number of leaf scans
+*/
+#define pq_leaf_scan_count(pq)                ((pq)->leafScanCount)
+
+
+
+
+
+/*
+ *  Initializes the given priority queue.
+ *
+ *  Parameter:
+ *      pq       	        :   Pointer to a priority queue to initialize
+ *		hOrientation        :	Orientation of the binary heap (min queue or max queue)
+ *      capacity            :   Total number of elements this priority queue is able to hold
+ *                              If the capacity becomes full at some point, the priority queue
+ *                              will allocate additional memory and increase this capacity
+ *                              by double (see pq_set_growth_policy()).
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *						        of the priority queue
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *						        of the priority queue
+ *                              (can be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the priority queue is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_init(
+    PriorityQueue *pq,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int capacity,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Initializes the given priority queue with an explicitly chosen storage engine.
+ *  pq_init() is equivalent to calling this function with PQ_ENGINE_BINARY_HEAP.
+ *
+ *  PQ_ENGINE_BINARY_HEAP keeps a single binary heap oriented towards one extreme.
+ *  The opposite extreme is tracked on insert, or found by a scan of the leaves
+ *  (the last half of the array) when unknown, so peeking it does not modify
+ *  the heap. The whole heap is rebuilt towards the opposite extreme only after
+ *  several pulls in a row from that end, which is cheap for workloads that
+ *  mostly pull from one end.
+ *  PQ_ENGINE_MINMAX_HEAP keeps a min-max heap, both peek operations commit
+ *  in O(1) time and both pull operations commit in O(logn) time regardless
+ *  of the order in which they are called. The heap orientation is ignored.
+ *  PQ_ENGINE_DARY4_HEAP and PQ_ENGINE_DARY8_HEAP behave like the binary heap,
+ *  but every node has 4 (or 8) children. The tree is 2 (or 3) times shallower,
+ *  which makes insertions cheaper and pulls do more comparisons per level.
+ *  The array is laid out so that the children of every node start on a
+ *  cache line boundary: all 4 children (64 bytes of PQnode on 64-bit targets)
+ *  share a single cache line, all 8 children share a pair of cache lines.
+ *  PQ_ENGINE_PAIRING_HEAP keeps a pairing heap oriented towards one extreme, whose
+ *  nodes stay in the PQnode array (which serves as their pool) and are linked
+ *  to each other by index. Insertion links the new node to the root, and so does
+ *  a priority change towards the heap orientation which moves a node above its
+ *  parent (decrease-key of a min heap), both in O(1) time. Pulls from the oriented
+ *  end take O(logn) amortized time. The opposite extreme is found by a scan of
+ *  the childless nodes, and the heap is re-oriented (re-paired in O(n) time)
+ *  after several pulls in a row from that end, like PQ_ENGINE_BINARY_HEAP.
+ *  PQ_ENGINE_RADIX_HEAP needs a key function and is initialized by pq_init_radix().
+ *
+ *  Parameter:
+ *      pq       	        :   Pointer to a priority queue to initialize
+ *      engine              :   Storage engine of the priority queue
+ *		hOrientation        :	Orientation of the binary heap (min queue or max queue)
+ *      capacity            :   Total number of elements this priority queue is able to hold
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *                              (can be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the priority queue is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_init_engine(
+    PriorityQueue *pq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int capacity,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Initializes the given priority queue, all the memory of which (node array,
+ *  position map and temporary buffers) is obtained from the specified allocator
+ *  instead of malloc(), realloc() & free().
+ *  pq_init_engine() is equivalent to calling this function with a NULL allocator.
+ *
+ *  Parameter:
+ *      pq       	        :   Pointer to a priority queue to initialize
+ *      engine              :   Storage engine of the priority queue
+ *		hOrientation        :	Orientation of the binary heap (min queue or max queue)
+ *      capacity            :   Total number of elements this priority queue is able to hold
+ *      allocator           :   Allocator of the priority queue, copied into the queue
+ *                              (can be NULL for malloc(), realloc() & free())
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *                              (can be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the priority queue is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_init_allocator(
+    PriorityQueue *pq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int capacity,
+    const PQallocator *allocator,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Initializes the given priority queue as a monotone radix heap (PQ_ENGINE_RADIX_HEAP),
+ *  for priorities which map to unsigned integer keys and are pulled in increasing
+ *  order, as the timestamps of an event simulation or the distances of Dijkstra.
+ *
+ *  The nodes are kept in 65 buckets by the highest bit in which their key differs
+ *  from the key of the last pulled minimum. Both insert and pull of the minimum
+ *  take O(1) amortized time (each node is moved to a lower bucket at most 64 times),
+ *  independent of the number of elements. The maximum is found by a scan of
+ *  the highest non-empty bucket.
+ *
+ *  A radix heap requires that no inserted (or reassigned) key is smaller than the
+ *  key of the minimum last pulled or peeked (pq_pull_minimum(), pq_peek_minimum()).
+ *  When that happens, the queue falls back to
+ *  PQ_ENGINE_BINARY_HEAP (heap orientation PQ_HEAP_MIN) with a heap built from
+ *  its current elements, counted by pq_rebuild_count(), and continues from there
+ *  ordered by fpComparePriority, which must order the priorities like their keys.
+ *
+ *  Parameter:
+ *      pq       	        :   Pointer to a priority queue to initialize
+ *      capacity            :   Total number of elements this priority queue is able to hold
+ *      allocator           :   Allocator of the priority queue, copied into the queue
+ *                              (can be NULL for malloc(), realloc() & free())
+ *      fpPriorityKey       :   Pointer to the function which maps a priority element
+ *                              to its unsigned integer key (can not be NULL)
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *                              (can be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the priority queue is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_init_radix(
+    PriorityQueue *pq,
+    unsigned int capacity,
+    const PQallocator *allocator,
+    unsigned long long (*fpPriorityKey) (const void *priority),
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Initializes the given priority queue and loads it with an array of elements
+ *  and an array of their priorities at once. The heap is built bottom-up
+ *  in O(n) time, instead of O(nlogn) time taken by n calls of pq_insert_with_priority.
+ *  The capacity of the queue is the number of supplied elements (at least 1).
+ *
+ *  Parameter:
+ *      pq       	        :   Pointer to a priority queue to initialize
+ *      engine              :   Storage engine of the priority queue
+ *		hOrientation        :	Orientation of the binary heap (min queue or max queue)
+ *      elems               :   Array of count pointers to elements (can be NULL if count is 0)
+ *      priorities          :   Array of count pointers to the priority elements,
+ *                              priorities[i] is the priority of elems[i]
+ *                              (can be NULL if count is 0)
+ *      count               :   Number of elements in both arrays
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *                              (can be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the priority queue is initialized and loaded successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_init_from_array(
+    PriorityQueue *pq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    const void **elems,
+    const void **priorities,
+    unsigned int count,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Destroys the given priority queue.
+ *	Releases all the resources occupied by the queue.
+ *	if fpDestroyPriority or fpDestroyElement functions are provided,
+ *	then those functions are called for each priority element and each element
+ *	to destroy all the containing elements along with their priority elements.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue to destroy
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_destroy(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Sets the growth policy of the specified priority queue.
+ *	A full array grows to (growthPercent) percent of its capacity, the memory block
+ *	is resized with realloc() (of the allocator), which usually extends it in place
+ *	or remaps its pages instead of copying them.
+ *	When the number of elements drops below (shrinkPercent) percent of the capacity,
+ *	the array shrinks so that it is (100 * 100 / growthPercent) percent full again,
+ *	but never below the capacity given at initialization or to pq_reserve().
+ *	The gap between both percentages (hysteresis) guarantees that a queue oscillating
+ *	around a size does not grow and shrink again and again.
+ *	The defaults are PQ_DEFAULT_GROWTH_PERCENT and PQ_DEFAULT_SHRINK_PERCENT.
+ *
+ *  Parameter:
+ *      pq       	    :   Pointer to a priority queue
+ *      growthPercent   :   Capacity after growth in percent of the old capacity (more than 100)
+ *      shrinkPercent   :   Fill percent which triggers shrinking (0 disables shrinking)
+ *                          (growthPercent * shrinkPercent must be less than 10000)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the policy is set
+ *						(failure) -1 if any of the supplied parameters is invalid
+*/
+int pq_set_growth_policy(PriorityQueue *pq, unsigned int growthPercent, unsigned int shrinkPercent);
+
+
+
+
+
+/*
+ *  Makes room for at least the specified number of elements in the specified
+ *  priority queue, so that inserting them allocates no memory. Automatic shrinking
+ *  never reduces the capacity below this number afterwards.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      capacity    :   Number of elements to make room for (at most PQ_CAPACITY_MAX)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the capacity is large enough or has been expanded
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_reserve(PriorityQueue *pq, size_t capacity);
+
+
+
+
+
+/*
+ *  Reduces the capacity of the specified priority queue to the number of elements
+ *  it currently holds (at least 1), and lowers the limit of automatic shrinking
+ *  to that capacity.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the capacity has been reduced (or was already minimal)
+ *						(failure) -1 if the priority queue is NULL
+ *                      (failure) -2 if failed to reallocate memory
+*/
+int pq_shrink_to_fit(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Copies the work counters of the specified priority queue (see PQstats).
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      stats       :   Pointer to a PQstats which receives the counters
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the counters are copied
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      (failure) -3 if the library is compiled without PQ_ENABLE_STATS
+ *                      (rebuilds and leafScans are copied all the same, the rest is 0)
+*/
+int pq_stats_get(const PriorityQueue *pq, PQstats *stats);
+
+
+
+
+
+/*
+ *  Sets all the work counters of the specified priority queue to 0.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the counters are reset
+ *						(failure) -1 if the priority queue is NULL
+*/
+int pq_stats_reset(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Insets an element with a priority associated into the specified priority queue.
+ *  Both the priority and the elem can point to the same element/object in memory
+ *  at the same time and can not be NULL.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *		elem		:	Pointer to the element which is being inserted with the priority
+ *                      (can not be NULL)
+ *		priority	:	Pointer to the priority element which is the priority of elem element
+ *                      (can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the elem is successfully inserted
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if the queue is full and additional memory is not available
+*/
+int pq_insert_with_priority(PriorityQueue *pq, const void *elem, const void *priority);
+
+
+
+
+
+
+/*
+ *  Insets an element with a priority associated into the specified priority queue
+ *  and returns a handle of the new node, which can later be used by
+ *  pq_reassign_priority_handle() and pq_remove() to locate the node in O(1) time.
+ *  The handle stays valid until the element leaves the queue (by a pull, pq_remove
+ *  or pq_destroy), after that it may be issued again to another element.
+ *  The first call of this function allocates a position map for the queue,
+ *  which is maintained by every operation afterwards.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *		elem		:	Pointer to the element which is being inserted with the priority
+ *                      (can not be NULL)
+ *		priority	:	Pointer to the priority element which is the priority of elem element
+ *                      (can not be NULL)
+ *      handle      :   Pointer to a handle which will receive the handle of the new node
+ *                      (can be NULL, then this function behaves as pq_insert_with_priority)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the elem is successfully inserted
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if the queue is full and additional memory is not available
+*/
+int pq_insert_with_handle(PriorityQueue *pq, const void *elem, const void *priority, PQhandle *handle);
+
+
+
+
+
+/*
+ *  Insets many elements with their priorities into the specified priority queue at once.
+ *  The underlying array is grown at most once, all the nodes are appended and
+ *  the heap property is restored either by moving each new node up (when few nodes
+ *  are added to a large queue) or by rebuilding the whole heap bottom-up in O(n+k) time,
+ *  whichever is cheaper. The new elements do not receive handles.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *		elems		:	Array of count pointers to the elements being inserted
+ *                      (can not be NULL, nor any of its items)
+ *		priorities	:	Array of count pointers to the priority elements,
+ *                      priorities[i] is the priority of elems[i]
+ *                      (can not be NULL, nor any of its items)
+ *      count       :   Number of elements in both arrays
+ *
+ *  Returns:
+ *      (int)			(success) 0 if all the elements are successfully inserted
+ *						(failure) -1 if the supplied parameters are invalid (nothing is inserted)
+ *                      (failure) -2 if additional memory is not available (nothing is inserted)
+*/
+int pq_insert_batch(PriorityQueue *pq, const void **elems, const void **priorities, unsigned int count);
+
+
+
+
+
+
+/*
+ *  Moves all the elements of the source priority queue into the destination
+ *  priority queue, leaving the source empty (but initialized). The array of the
+ *  destination is grown at most once and the source nodes are appended to it,
+ *  then the heap is restored in the Heap Orientation of the destination, either
+ *  by moving each new node up (when the source is small) or by rebuilding the
+ *  whole heap bottom-up in O(n+m) time, like pq_insert_batch(). Two pairing heaps
+ *  of the same orientation are melded by linking their roots.
+ *  The handles of the source are released and the moved elements receive none.
+ *  A source restored by pq_snapshot_load() hands its mapping over to the
+ *  destination, which then must not hold a mapping of its own and must use the
+ *  same destroy functions as the source; the mapping lives until the destination
+ *  is destroyed.
+ *
+ *  Parameter:
+ *      dst         :   Pointer to the priority queue which receives the elements
+ *      src         :   Pointer to the priority queue whose elements are moved,
+ *                      which must use the same compare function (fpComparePriority)
+ *                      and can not be dst
+ *
+ *  Returns:
+ *      (int)			(success) 0 if all the elements are moved
+ *						(failure) -1 if the supplied parameters are invalid (nothing is moved)
+ *                      (failure) -2 if additional memory is not available (nothing is moved)
+*/
+int pq_merge(PriorityQueue *dst, PriorityQueue *src);
+
+
+
+
+
+
+/*
+ *  Copies all the elements of the priority queue, sorted by priority, into the
+ *  caller's arrays without changing the queue (for persistence or reporting).
+ *  A copy of the underlying array is heapsorted in O(nlogn) time, which skips
+ *  building the heap when the storage engine is PQ_ENGINE_BINARY_HEAP.
+ *  Equal priorities come out in no particular order.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      ascending   :   Nonzero for the minimum priority first, 0 for the maximum first
+ *		priorities	:	Array of at least pq_size(pq) pointers which receives the priorities
+ *						(can not be NULL)
+ *		elems		:	Array of at least pq_size(pq) pointers which receives the elements,
+ *                      elems[i] is the element of priorities[i] (can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if all the elements are copied
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if memory for the copy is not available
+*/
+int pq_export_sorted(PriorityQueue *pq, int ascending, void **priorities, void **elems);
+
+
+
+
+
+/*
+ *  Removes all the elements from the priority queue into the caller's arrays,
+ *  sorted by priority, like pq_export_sorted() but without the copy: the
+ *  underlying array is heapsorted in place, so no memory is needed.
+ *  The queue is left empty and all of its handles are released.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      ascending   :   Nonzero for the minimum priority first, 0 for the maximum first
+ *		priorities	:	Array of at least pq_size(pq) pointers which receives the priorities
+ *						(can not be NULL)
+ *		elems		:	Array of at least pq_size(pq) pointers which receives the elements,
+ *                      elems[i] is the element of priorities[i] (can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if all the elements are removed
+ *						(failure) -1 if the supplied parameters are invalid
+*/
+int pq_drain_sorted(PriorityQueue *pq, int ascending, void **priorities, void **elems);
+
+
+
+
+
+
+/*
+ *  Saves the priority queue into a file, to be restored by pq_snapshot_load():
+ *  the array of nodes in its current heap order, the Heap Orientation, the
+ *  number of nodes, the capacity and the buckets of a radix heap or the links
+ *  of a pairing heap. The priorities and the elements are converted to bytes
+ *  by the serializer (see PQserializer). The queue does not change, and the
+ *  file is removed again if the snapshot could not be completed.
+ *  The snapshot is only readable on machines of the same byte order and sizes.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      path        :   Name of the file which receives the snapshot (replaced if it exists)
+ *      serializer  :   Pointer to the functions (or flat sizes) which save the
+ *                      priorities and the elements
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the snapshot is saved
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if memory for the buffer is not available
+ *                      (failure) -3 if the file cannot be written or an object cannot be saved
+*/
+int pq_snapshot_save(PriorityQueue *pq, const char *path, const PQserializer *serializer);
+
+
+
+
+
+/*
+ *  Restores a snapshot saved by pq_snapshot_save() into an empty priority queue,
+ *  which was initialized with the compare function (and the destroy functions)
+ *  of the saved queue. The file is mapped into memory (read into a block of the
+ *  allocator where mmap() is not available, as on MinGW) and the array grows once
+ *  to the saved capacity. When the storage engine of the queue is the saved one,
+ *  the nodes are restored in their saved heap order and orientation, so no heap
+ *  is built again (the saved radix buckets or pairing links are checked first);
+ *  otherwise the heap is built over them in O(n) time.
+ *  The flat objects (see PQserializer) point into a private mapping of the file,
+ *  which stays until pq_destroy(); a queue holds the mapping of one snapshot only.
+ *  The restored elements receive no handles.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to an empty priority queue
+ *      path        :   Name of the file which holds the snapshot
+ *      serializer  :   Pointer to the functions (or flat sizes) which load the
+ *                      priorities and the elements, the flat sizes must be the saved
+ *                      ones and the queue must have no destroy function for flat objects
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the snapshot is restored
+ *						(failure) -1 if the supplied parameters are invalid or the queue is not empty
+ *                      (failure) -2 if additional memory is not available (nothing is restored)
+ *                      (failure) -3 if the file cannot be read, is not a valid snapshot or
+ *                      an object cannot be loaded (nothing is restored)
+*/
+int pq_snapshot_load(PriorityQueue *pq, const char *path, const PQserializer *serializer);
+
+
+
+
+
+/*
+ *  Retrives but does not remove the element with minimum priority from the priority queue.
+ *	The element with minimum priority will be determined by the compare
+ *	function (fpComparePriority) provided with the priority queue.
+ *  If the heap orientation of the specified priority queue is PQ_HEAP_MIN
+ *  then this operation will commit in O(1) time.
+ *  Otherwise, in case if the heap orientation is PQ_HEAP_MAX, the minimum is the
+ *  opposite extreme, which is tracked on insert or else located by a scan of the
+ *  leaves in O(n) time (where n = Number of element on the priority queue) and
+ *  remembered until the nodes move. A peek never modifies the heap.
+ *  If the storage engine is PQ_ENGINE_MINMAX_HEAP, this operation always
+ *  commits in O(1) time and the heap orientation is not consulted.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *		priority	:	Pointer to a pointer which will receive the priority
+ *						(can not be NULL)
+ *		elem		:	Pointer to a pointer which will receive the minimum element
+ *						(can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the minimum key is retrived
+ *						(failure) -1 otherwise (the queue is empty or pq is NULL)
+*/
+int pq_peek_minimum(PriorityQueue *pq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Retrives but does not remove the element with maximum priority from the priority queue.
+ *	The element with maximum priority will be determined by the compare
+ *	function (fpComparePriority) provided with the priority queue.
+ *  If the heap orientation of the specified priority queue is PQ_HEAP_MAX
+ *  then this operation will commit in O(1) time.
+ *  Otherwise, in case if the heap orientation is PQ_HEAP_MIN, the maximum is the
+ *  opposite extreme, which is tracked on insert or else located by a scan of the
+ *  leaves in O(n) time (where n = Number of element on the priority queue) and
+ *  remembered until the nodes move. A peek never modifies the heap.
+ *  If the storage engine is PQ_ENGINE_MINMAX_HEAP, this operation always
+ *  commits in O(1) time and the heap orientation is not consulted.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *		priority	:	Pointer to a pointer which will receive the priority
+ *						(can not be NULL)
+ *		elem		:	Pointer to a pointer which will receive the maximum element
+ *						(can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the maximum key is retrived
+ *						(failure) -1 otherwise (the queue is empty or pq is NULL)
+*/
+int pq_peek_maximum(PriorityQueue *pq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Retrives and removes the element with minimum priority from the priority queue.
+ *	The element with minimum priority will be determined by the compare
+ *	function (fpComparePriority) provided with the priority queue.
+ *  If the heap orientation of the specified priority queue is PQ_HEAP_MIN
+ *  then this operation will commit in O(logn) time.
+ *  Otherwise, in case if the heap orientation is PQ_HEAP_MAX, the minimum is
+ *  pulled from the leaves, located as by pq_peek_minimum() in O(n) time (where
+ *  n = Number of element on the priority queue). On the 4th pull in a row from
+ *  this end the heap is rebuilt as a PQ_HEAP_MIN type in O(n) time instead, and
+ *  the following pulls commit in O(logn) time again.
+ *  If the storage engine is PQ_ENGINE_MINMAX_HEAP, this operation always
+ *  commits in O(logn) time and the heap orientation is not consulted.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *		priority	:	Pointer to a pointer which will receive the priority
+ *						(can not be NULL)
+ *		elem		:	Pointer to a pointer which will receive the minimum element
+ *						(can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the minimum key is retrived and removed
+ *						(failure) -1 otherwise (the queue is empty or pq is NULL)
+*/
+int pq_pull_minimum(PriorityQueue *pq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Retrives and removes the element with maximum priority from the priority queue.
+ *	The element with maximum priority will be determined by the compare
+ *	function (fpComparePriority) provided with the priority queue.
+ *  If the heap orientation of the specified priority queue is PQ_HEAP_MAX
+ *  then this operation will commit in O(logn) time.
+ *  Otherwise, in case if the heap orientation is PQ_HEAP_MIN, the maximum is
+ *  pulled from the leaves, located as by pq_peek_maximum() in O(n) time (where
+ *  n = Number of element on the priority queue). On the 4th pull in a row from
+ *  this end the heap is rebuilt as a PQ_HEAP_MAX type in O(n) time instead, and
+ *  the following pulls commit in O(logn) time again.
+ *  If the storage engine is PQ_ENGINE_MINMAX_HEAP, this operation always
+ *  commits in O(logn) time and the heap orientation is not consulted.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *		priority	:	Pointer to a pointer which will receive the priority
+ *						(can not be NULL)
+ *		elem		:	Pointer to a pointer which will receive the maximum element
+ *						(can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the maximum key is retrived and removed
+ *						(failure) -1 otherwise (the queue is empty or pq is NULL)
+*/
+int pq_pull_maximum(PriorityQueue *pq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Retrives and removes up to k elements with minimum priorities from the priority queue,
+ *  in ascending order of their priorities. Arguments are validated and the heap
+ *  orientation is checked only once for the whole batch, so this operation is
+ *  cheaper than k calls of pq_pull_minimum. A heap oriented away from the minimum is
+ *  rebuilt as a PQ_HEAP_MIN type once, in O(n) time, unless fewer than 4 elements
+ *  are requested, which are pulled from the leaves one by one.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      k           :   Maximum number of elements to retrive
+ *		priorities	:	Array of at least k pointers which will receive the priorities
+ *						(can not be NULL)
+ *		elems		:	Array of at least k pointers which will receive the elements
+ *						(can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) Number of elements retrived and removed (0 if the queue is empty)
+ *						(failure) -1 if the supplied parameters are invalid
+*/
+int pq_pull_min_k(PriorityQueue *pq, unsigned int k, void **priorities, void **elems);
+
+
+
+
+
+/*
+ *  Retrives and removes up to k elements with maximum priorities from the priority queue,
+ *  in descending order of their priorities. Arguments are validated and the heap
+ *  orientation is checked only once for the whole batch, so this operation is
+ *  cheaper than k calls of pq_pull_maximum. A heap oriented away from the maximum is
+ *  rebuilt as a PQ_HEAP_MAX type once, in O(n) time, unless fewer than 4 elements
+ *  are requested, which are pulled from the leaves one by one.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      k           :   Maximum number of elements to retrive
+ *		priorities	:	Array of at least k pointers which will receive the priorities
+ *						(can not be NULL)
+ *		elems		:	Array of at least k pointers which will receive the elements
+ *						(can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) Number of elements retrived and removed (0 if the queue is empty)
+ *						(failure) -1 if the supplied parameters are invalid
+*/
+int pq_pull_max_k(PriorityQueue *pq, unsigned int k, void **priorities, void **elems);
+
+
+
+
+
+/*
+ *  Retrives but does not remove up to k elements with minimum priorities from the
+ *  priority queue, in ascending order of their priorities. The queue is not modified
+ *  at all, the heap orientation is never transformed.
+ *  When the heap is oriented towards the minimum (or the engine is PQ_ENGINE_MINMAX_HEAP)
+ *  a small auxiliary heap walks the top of the heap and this operation commits
+ *  in O(klogk) time. Otherwise every element is examined in O(nlogk) time.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      k           :   Maximum number of elements to retrive
+ *		priorities	:	Array of at least k pointers which will receive the priorities
+ *						(can not be NULL)
+ *		elems		:	Array of at least k pointers which will receive the elements
+ *						(can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) Number of elements retrived (0 if the queue is empty)
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if failed to allocate the auxiliary memory
+*/
+int pq_peek_min_k(PriorityQueue *pq, unsigned int k, void **priorities, void **elems);
+
+
+
+
+
+/*
+ *  Retrives but does not remove up to k elements with maximum priorities from the
+ *  priority queue, in descending order of their priorities. The queue is not modified
+ *  at all, the heap orientation is never transformed.
+ *  When the heap is oriented towards the maximum (or the engine is PQ_ENGINE_MINMAX_HEAP)
+ *  a small auxiliary heap walks the top of the heap and this operation commits
+ *  in O(klogk) time. Otherwise every element is examined in O(nlogk) time.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      k           :   Maximum number of elements to retrive
+ *		priorities	:	Array of at least k pointers which will receive the priorities
+ *						(can not be NULL)
+ *		elems		:	Array of at least k pointers which will receive the elements
+ *						(can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) Number of elements retrived (0 if the queue is empty)
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if failed to allocate the auxiliary memory
+*/
+int pq_peek_max_k(PriorityQueue *pq, unsigned int k, void **priorities, void **elems);
+
+
+
+
+
+/*
+ *  Reassign (change) the priority associated to an existing element in the priority queue.
+ *  This is an O(n) time operation, where n is the number of elements this queue is holding.
+ *  Elements inserted by pq_insert_with_handle() can be updated in O(logn) time
+ *  by pq_reassign_priority_handle() instead.
+ *
+ *  Parameter:
+ *      pq              :   Pointer to a priority queue
+ *      fpCompareElement:   Pointer to a function which will be used to identify
+ *                          the location of the element (elem) by comparing this element (elem)
+ *                          with the elements exist in this priority queue
+ *                          (can not be NULL).
+ *                          At least the equality comparison is required from this
+ *                          comparison function, such that it will return 0 when
+ *                          two elements are considered equal.
+ *                          It is fine if this comparison function implements 'total order'.
+ *      elem            :   Pointer to an element which must exists into the specified
+ *                          priority queue. It is vital that it must exists because
+ *                          the priority associated with it is being changed
+ *                          (can not be NULL).
+ *      priority        :   Pointer to a priority element which is being assigned as the new
+ *                          priority of the (elem) element
+ *                          (can not be NULL).
+ *                          Just like the requirements of the 'insert' function, this
+ *                          priority element and the elem element can be same. In other
+ *                          words, they can point to the same element/object in memory
+ *                          at the same time.
+ *      oldPriority     :   Pointer to a pointer which will receive the memory location of
+ *                          the old priority element which is being replaced by the new
+ *                          priority element.
+ *                          (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the priority is successfully reassigned
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if the specified element does not exist on the queue
+*/
+int pq_reassign_priority(
+    PriorityQueue *pq,
+    int (*fpCompareElement) (const void *arg1, const void *arg2),
+    const void *elem,
+    const void *priority,
+    void **oldPriority
+);
+
+
+
+
+
+
+/*
+ *  Reassign (change) the priority associated to the element identified by a handle
+ *  (obtained from pq_insert_with_handle). This is an O(logn) time operation.
+ *
+ *  Parameter:
+ *      pq              :   Pointer to a priority queue
+ *      handle          :   Handle of the element whose priority is being changed
+ *      priority        :   Pointer to a priority element which is being assigned as the new
+ *                          priority of the element
+ *                          (can not be NULL)
+ *      oldPriority     :   Pointer to a pointer which will receive the memory location of
+ *                          the old priority element which is being replaced
+ *                          (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the priority is successfully reassigned
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if the handle does not identify an element of the queue
+*/
+int pq_reassign_priority_handle(
+    PriorityQueue *pq,
+    PQhandle handle,
+    const void *priority,
+    void **oldPriority
+);
+
+
+
+
+
+/*
+ *  Retrives and removes the element identified by a handle (obtained from
+ *  pq_insert_with_handle), wherever it is located in the queue.
+ *  This is an O(logn) time operation. The handle is released.
+ *
+ *  Parameter:
+ *      pq       	:   Pointer to a priority queue
+ *      handle      :   Handle of the element which is being removed
+ *		priority	:	Pointer to a pointer which will receive the priority
+ *						(can be NULL)
+ *		elem		:	Pointer to a pointer which will receive the element
+ *						(can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is removed
+ *						(failure) -1 if the supplied parameters are invalid
+ *                      (failure) -2 if the handle does not identify an element of the queue
+*/
+int pq_remove(PriorityQueue *pq, PQhandle handle, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Initializes an empty arena. An arena hands out memory from large chunks
+ *  by bumping a pointer, and releases all of it at once in pq_arena_release().
+ *  Queues which live only as long as a request (or any other scope) can take
+ *  their memory from one arena of that scope, so they neither contend on the
+ *  global heap nor fragment it. An arena is not thread safe.
+ *
+ *  Parameter:
+ *      arena       :   Pointer to an arena to initialize
+ *      chunkSize   :   Minimum size in bytes of every chunk requested from malloc()
+ *                      (0 selects PQ_ARENA_DEFAULT_CHUNK_SIZE)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the arena is initialized successfully
+ *						(failure) -1 if the arena is NULL
+*/
+int pq_arena_init(PQarena *arena, size_t chunkSize);
+
+#define PQ_ARENA_DEFAULT_CHUNK_SIZE           65536
+
+
+
+
+
+/*
+ *  Fills an allocator, which takes its memory from the specified arena,
+ *  to be passed to pq_init_allocator().
+ *	Memory freed by a queue is reused only if it is the most recent block
+ *	of the arena, which lets the last created queue grow in place.
+ *
+ *  Parameter:
+ *      arena       :   Pointer to an initialized arena
+ *      allocator   :   Pointer to the allocator to fill
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_arena_allocator(PQarena *arena, PQallocator *allocator);
+
+
+
+
+
+/*
+ *  Releases all the memory of the specified arena in one shot. Every priority
+ *  queue created with an allocator of this arena becomes invalid, and must not
+ *  be used or destroyed afterwards. Call pq_destroy() on such a queue before
+ *  releasing the arena only if its elements have to be destroyed.
+ *	The arena stays initialized and can be used again.
+ *
+ *  Parameter:
+ *      arena       :   Pointer to an arena to release
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_arena_release(PQarena *arena);
+
+
+
+
+
+#endif
+
+
@@ -0,0 +1,263 @@
+/************************************************************************************
+    C++ Double Ended Priority Queue ADT
+    Based on Min-Max Heap Data Structure (Array Based)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef DOUBLE_ENDED_PQ_HPP
+#define DOUBLE_ENDED_PQ_HPP
+
+
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+
+
+namespace pq {
+    
+    
+    
+    
+/*
+ *  Header-only double ended priority queue of (Key, Value) pairs, for C++11 and later.
+ *
+ *  Keys and values are stored by value in one array, so a queue of
+ *  move-only types (std::unique_ptr, ...) works and no element needs an
+ *  allocation of its own. The comparator is a template parameter and is
+ *  inlined into the sift loops, unlike the function pointer of PriorityQueue.
+ *
+ *  The array is a min-max heap, the same algorithm as PQ_ENGINE_MINMAX_HEAP:
+ *  both extremes are peeked in O(1) time and pulled in O(logn) time in any order.
+ *  Nodes are moved into a hole instead of swapped, every move is a move
+ *  assignment of value_type.
+ *
+ *  Template parameters:
+ *      Key         :   Priority type, ordered by Compare
+ *      Value       :   Element type
+ *      Compare     :   Strict weak order of the keys (must not throw)
+ *      Alloc       :   Allocator of std::pair<Key, Value>
+ *
+ *  Calling a peek or pull member function on an empty queue is undefined,
+ *  like top() of std::priority_queue. Allocation failures throw std::bad_alloc.
+*/
+template <class Key, class Value, class Compare = std::less<Key>,
+          class Alloc = std::allocator<std::pair<Key, Value> > >
+class double_ended_queue {
+    
+public:
+    
+    typedef Key key_type;
+    typedef Value mapped_type;
+    typedef std::pair<Key, Value> value_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef std::size_t size_type;
+    typedef value_type &reference;
+    typedef const value_type &const_reference;
+    
+    
+    double_ended_queue() : nodes_(), compare_() {}
+    
+    explicit double_ended_queue(const Compare &compare, const Alloc &alloc = Alloc())
+        : nodes_(alloc), compare_(compare) {}
+    
+    explicit double_ended_queue(const Alloc &alloc) : nodes_(alloc), compare_() {}
+    
+    /* Loads a range of pairs at once, the heap is built bottom-up in O(n) time */
+    template <class InputIt>
+    double_ended_queue(InputIt first, InputIt last, const Compare &compare = Compare(),
+                       const Alloc &alloc = Alloc())
+        : nodes_(first, last, alloc), compare_(compare) {
+        build();
+    }
+    
+    
+    bool empty() const { return nodes_.empty(); }
+    size_type size() const { return nodes_.size(); }
+    size_type capacity() const { return nodes_.capacity(); }
+    void reserve(size_type capacity) { nodes_.reserve(capacity); }
+    void shrink_to_fit() { nodes_.shrink_to_fit(); }
+    void clear() { nodes_.clear(); }
+    
+    key_compare key_comp() const { return compare_; }
+    allocator_type get_allocator() const { return nodes_.get_allocator(); }
+    
+    
+    void insert(const Key &key, const Value &value) { emplace(key, value); }
+    void insert(Key &&key, Value &&value) { emplace(std::move(key), std::move(value)); }
+    void insert(value_type &&node) { emplace(std::move(node)); }
+    
+    /* Constructs the pair in place from args (as std::pair does, piecewise too) */
+    template <class... Args>
+    void emplace(Args &&... args) {
+        nodes_.emplace_back(std::forward<Args>(args)...);
+        push_up(nodes_.size() - 1);
+    }
+    
+    
+    const_reference peek_minimum() const {
+        assert(empty() == false);
+        return nodes_[0];
+    }
+    
+    const_reference peek_maximum() const {
+        assert(empty() == false);
+        return nodes_[max_index()];
+    }
+    
+    /* The pulled pair is moved out to the caller */
+    value_type pull_minimum() { return pull(0); }
+    value_type pull_maximum() { return pull(max_index()); }
+    
+    
+    void swap(double_ended_queue &other) {
+        using std::swap;
+        nodes_.swap(other.nodes_);
+        swap(compare_, other.compare_);
+    }
+    
+    
+private:
+    
+    typedef std::vector<value_type, Alloc> node_array;
+    
+    node_array nodes_;
+    Compare compare_;
+    
+    
+    /* The root is on a min level, the levels alternate from there */
+    static bool is_min_level(size_type index) {
+        bool isMin = true;
+        for (++index; index > 1; index >>= 1)
+            isMin = !isMin;
+        return isMin;
+    }
+    
+    /* True if a belongs closer to the root than b on a min (or max) level */
+    bool before(bool isMin, const value_type &a, const value_type &b) const {
+        return isMin ? compare_(a.first, b.first) : compare_(b.first, a.first);
+    }
+    
+    size_type max_index() const {
+        assert(empty() == false);
+        if (nodes_.size() < 3)
+            return nodes_.size() - 1;
+        return compare_(nodes_[1].first, nodes_[2].first) ? 2 : 1;
+    }
+    
+    
+    value_type pull(size_type index) {
+        value_type result(std::move(nodes_[index]));
+        value_type last(std::move(nodes_.back()));
+        nodes_.pop_back();
+        if (index < nodes_.size())
+            trickle_down(index, std::move(last));
+        return result;
+    }
+    
+    
+    /* Moves the node at index up among the nodes of its own kind of levels */
+    void push_up(size_type index) {
+        value_type node(std::move(nodes_[index]));
+        bool isMin = is_min_level(index);
+        size_type parent;
+    
+        /* A node which belongs to the other kind of levels continues from its parent */
+        if (index > 0) {
+            parent = (index - 1) / 2;
+            if (before(!isMin, node, nodes_[parent])) {
+                nodes_[index] = std::move(nodes_[parent]);
+                index = parent;
+                isMin = !isMin;
+            }
+        }
+    
+        /* Then the hole climbs by grandparents */
+        while (index > 2) {
+            parent = ((index - 1) / 2 - 1) / 2;
+            if (before(isMin, node, nodes_[parent]) == false)
+                break;
+            nodes_[index] = std::move(nodes_[parent]);
+            index = parent;
+        }
+        nodes_[index] = std::move(node);
+    }
+    
+    
+    /*  Moves the hole at index down until node fits, then stores node there.
+        The best of the children & grandchildren fills the hole each step,
+        a node stopped below a parent of the other kind trades places with it.
+    */
+    void trickle_down(size_type index, value_type &&node) {
+        value_type pending(std::move(node));
+        bool isMin = is_min_level(index);
+        size_type size = nodes_.size();
+        size_type child, best, last, parent;
+    
+        while ((child = 2 * index + 1) < size) {
+    
+            /* Children first, then grandchildren (at most 4) */
+            best = child;
+            if (child + 1 < size && before(isMin, nodes_[child + 1], nodes_[best]))
+                best = child + 1;
+            last = 4 * index + 6 < size ? 4 * index + 6 : size - 1;
+            for (size_type grand = 4 * index + 3; grand <= last; ++grand) {
+                if (before(isMin, nodes_[grand], nodes_[best]))
+                    best = grand;
+            }
+    
+            if (before(isMin, nodes_[best], pending) == false)
+                break;
+            nodes_[index] = std::move(nodes_[best]);
+            index = best;
+            if (best <= child + 1)
+                break;
+    
+            parent = (best - 1) / 2;
+            if (before(isMin, nodes_[parent], pending)) {
+                value_type other(std::move(nodes_[parent]));
+                nodes_[parent] = std::move(pending);
+                pending = std::move(other);
+            }
+        }
+        nodes_[index] = std::move(pending);
+    }
+    
+    
+    void build() {
+        for (size_type index = nodes_.size() / 2; index > 0; --index)
+            trickle_down(index - 1, std::move(nodes_[index - 1]));
+    }
+};
+    
+    
+    
+    
+template <class Key, class Value, class Compare, class Alloc>
+void swap(double_ended_queue<Key, Value, Compare, Alloc> &a,
+          double_ended_queue<Key, Value, Compare, Alloc> &b) {
+    a.swap(b);
+}
+    
+    
+    
+    
+}   /* namespace pq */
+
+
+
+
+#endif
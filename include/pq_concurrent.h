@@ -0,0 +1,663 @@
+
+
+/************************************************************************************
+    Thread Safe Double Ended Priority Queue ADT
+    Flat combining over a PriorityQueue
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef DOUBLE_ENDED_PQ_CONCURRENT_H
+#define DOUBLE_ENDED_PQ_CONCURRENT_H
+
+
+
+
+#include "pq.h"
+#include <pthread.h>
+
+
+
+
+
+
+
+
+/*********************************************************************************************/
+/***********************************                      ************************************/
+/***********************************    DATA STRUCTURES   ************************************/
+/***********************************                      ************************************/
+/*********************************************************************************************/
+
+
+
+
+/*
+ *  A thread which calls an operation publishes it in a free slot of the
+ *  publication array, then either waits until another thread has executed it,
+ *  or takes the combiner lock and executes the pending operations of all the
+ *  threads in one pass over the queue. The queue (and its cache lines) stays
+ *  with one thread at a time, and a single lock acquisition serves many
+ *  operations. The operations are linearizable (strictly ordered): every
+ *  operation takes effect at some point between its call and its return.
+*/
+struct PQconcurrent_ {
+    
+    PriorityQueue queue;                    /* The underlying queue, only touched by the combiner */
+    pthread_mutex_t combinerLock;           /* Held by the thread which is currently combining */
+    
+    struct PQcombineSlot_ *pSlots;          /* Publication array, one cache line per slot */
+    void *pSlotBlock;                       /* Memory block which holds pSlots */
+    unsigned int slotCount;                 /* Number of slots (simultaneous operations) */
+    
+    const void **pBatchElem;                /* Scratch arrays of the combiner, which */
+    const void **pBatchPriority;            /* Collects the inserts of a pass into one batch */
+    unsigned int *pBatchSlot;               /* Slot of every insert of the batch */
+    
+    unsigned int nodeCount;                 /* Copy of the queue size, readable without the lock */
+    
+};
+typedef struct PQconcurrent_ PQconcurrent;
+
+
+#define PQ_CONCURRENT_DEFAULT_SLOTS         64
+
+
+/*
+ *  A bounded lock-free ring buffer in front of a PriorityQueue, for many
+ *  producer threads which only insert and a single consumer thread which pulls.
+ *  A producer claims a cell with one compare-and-swap and never touches the heap.
+ *  The consumer moves all the published cells into the queue with one
+ *  pq_insert_batch() call (which heapifies large batches bottom-up) right before
+ *  every pull, so the producers never wait for a sift.
+*/
+struct PQingest_ {
+    
+    unsigned int enqueuePos;                /* Next cell to claim, shared by the producers */
+    unsigned char padEnqueue[PQ_CACHE_LINE_SIZE - sizeof(unsigned int)];
+    
+    unsigned int dequeuePos;                /* Next cell to drain, owned by the consumer */
+    unsigned int capacity;                  /* Number of cells, a power of 2 */
+    struct PQingestCell_ *pCells;           /* The cells of the ring */
+    PriorityQueue *pq;                      /* The attached queue, owned by the consumer */
+    
+    const void **pBatchElem;                /* Drained elements which wait for pq_insert_batch() */
+    const void **pBatchPriority;            /* Drained priorities which wait for pq_insert_batch() */
+    unsigned int batchCount;                /* Number of drained elements not inserted yet */
+    
+};
+typedef struct PQingest_ PQingest;
+
+
+
+/*
+ *  A relaxed (approximate) priority queue for many threads, built as a
+ *  MultiQueue: the elements are spread over several min-max heaps, each with a
+ *  lock of its own. An insert goes to a random heap, a pull compares the
+ *  extremes of a few randomly chosen heaps and takes the best of them. No
+ *  root is shared by all the threads, at the price of order: a pull returns
+ *  one of the best elements, on average among the best queueCount or so.
+ *  More heaps allow more parallelism, more choices per pull give better order.
+*/
+struct PQrelaxed_ {
+    
+    union PQrelaxedPart_ *pParts;           /* The heaps with their locks, one cache line apart */
+    void *pPartBlock;                       /* Memory block which holds pParts */
+    PQallocator allocator;                  /* Allocator of pPartBlock and of every heap */
+    unsigned int partCount;                 /* Number of heaps */
+    unsigned int choiceCount;               /* Number of heaps compared by a pull */
+    
+    unsigned int nodeCount;                 /* Number of elements in all the heaps, accessed atomically */
+    unsigned int sampleInterval;            /* Every sampleInterval-th pull measures its rank error (0: never) */
+    
+    unsigned long long pullCount;           /* Statistics, accessed atomically */
+    unsigned long long sampleCount;
+    unsigned long long rankErrorSum;
+    unsigned long long rankErrorMax;
+    
+    int (*fpComparePriority) (const void *pr1, const void *pr2);
+};
+typedef struct PQrelaxed_ PQrelaxed;
+
+
+/*
+ *  Rank error of a pull: the number of elements which were better than the
+ *  pulled one (lower for a minimum, higher for a maximum) and stayed in the
+ *  queue. A strict queue always has rank error 0.
+*/
+struct PQrelaxedStats_ {
+    
+    unsigned long long pullCount;           /* Number of successful pulls */
+    unsigned long long sampleCount;         /* Number of pulls whose rank error was measured */
+    unsigned long long rankErrorSum;        /* Sum of the measured rank errors */
+    unsigned long long rankErrorMax;        /* Largest measured rank error */
+};
+typedef struct PQrelaxedStats_ PQrelaxedStats;
+
+
+#define PQ_RELAXED_DEFAULT_CHOICES          2
+
+
+
+
+
+
+/*********************************************************************************************/
+/***********************************                      ************************************/
+/***********************************   PUBLIC INTERFACES  ************************************/
+/***********************************                      ************************************/
+/*********************************************************************************************/
+
+
+
+/*
+ *  Returns the number of elements the concurrent priority queue is holding.
+ *	The value may be outdated as soon as it is returned, when other threads
+ *	are modifying the queue.
+ *
+ *  Parameter:
+ *      cq       	:   Pointer to a concurrent priority queue
+ *
+ *  Returns:
+ *      (unsigned int)	Number of current elements
+*/
+#define pq_concurrent_size(cq)              (__atomic_load_n(&(cq)->nodeCount, __ATOMIC_RELAXED))
+
+
+
+
+
+/*
+ *  Initializes the given concurrent priority queue.
+ *	PQ_ENGINE_MINMAX_HEAP is the engine of choice when threads pull from both
+ *	ends, the other engines rebuild their heap whenever the requested end changes.
+ *
+ *  Parameter:
+ *      cq       	        :   Pointer to a concurrent priority queue to initialize
+ *      engine              :   Storage engine of the underlying priority queue
+ *		hOrientation        :	Orientation of the heap (min queue or max queue)
+ *      capacity            :   Initial capacity of the underlying priority queue
+ *      slotCount           :   Number of operations which can be published at the same time,
+ *                              usually the number of threads (0 selects PQ_CONCURRENT_DEFAULT_SLOTS)
+ *                              More threads than slots work too, they wait for a free slot
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *                              (can be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the queue is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory or to create the lock
+*/
+int pq_concurrent_init(
+    PQconcurrent *cq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int capacity,
+    unsigned int slotCount,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Destroys the given concurrent priority queue, like pq_destroy().
+ *	No other thread may use the queue during or after this call.
+ *
+ *  Parameter:
+ *      cq       	:   Pointer to a concurrent priority queue to destroy
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_concurrent_destroy(PQconcurrent *cq);
+
+
+
+
+
+/*
+ *  Inserts an element with a priority associated into the specified queue,
+ *	like pq_insert_with_priority(). Safe to call from any number of threads.
+ *	The inserts which are pending at the same time are loaded with pq_insert_batch().
+ *
+ *  Parameter:
+ *      cq       	:   Pointer to a concurrent priority queue
+ *      elem       	:   Pointer to the element to insert (can not be NULL)
+ *      priority    :   Pointer to the priority of the element (can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is inserted successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_concurrent_insert_with_priority(PQconcurrent *cq, const void *elem, const void *priority);
+
+
+
+
+
+/*
+ *  Removes the element with the lowest priority from the specified queue,
+ *	like pq_pull_minimum(). Safe to call from any number of threads.
+ *
+ *  Parameter:
+ *      cq       	:   Pointer to a concurrent priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is removed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+*/
+int pq_concurrent_pull_minimum(PQconcurrent *cq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Removes the element with the highest priority from the specified queue,
+ *	like pq_pull_maximum(). Safe to call from any number of threads.
+ *
+ *  Parameter:
+ *      cq       	:   Pointer to a concurrent priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is removed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+*/
+int pq_concurrent_pull_maximum(PQconcurrent *cq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Returns the element with the lowest priority without removing it,
+ *	like pq_peek_minimum(). Safe to call from any number of threads.
+ *
+ *  Parameter:
+ *      cq       	:   Pointer to a concurrent priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is accessed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+*/
+int pq_concurrent_peek_minimum(PQconcurrent *cq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Returns the element with the highest priority without removing it,
+ *	like pq_peek_maximum(). Safe to call from any number of threads.
+ *
+ *  Parameter:
+ *      cq       	:   Pointer to a concurrent priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is accessed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+*/
+int pq_concurrent_peek_maximum(PQconcurrent *cq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Attaches a ring buffer of the specified size to a priority queue.
+ *	The queue must be used only through the pq_ingest_ functions of the
+ *	consumer thread as long as the ring is attached.
+ *
+ *  Parameter:
+ *      ring        :   Pointer to a ring buffer to initialize
+ *      pq          :   Pointer to an initialized priority queue
+ *      capacity    :   Number of cells, rounded up to a power of 2
+ *                      (inserts fail while that many are waiting to be drained)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the ring buffer is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_ingest_init(PQingest *ring, PriorityQueue *pq, unsigned int capacity);
+
+
+
+
+
+/*
+ *  Drains the remaining elements into the attached queue and releases the ring
+ *	buffer. The queue itself is not destroyed. No producer may use the ring
+ *	during or after this call.
+ *
+ *  Parameter:
+ *      ring        :   Pointer to a ring buffer to destroy
+ *
+ *  Returns:
+ *      (int)			(success) 0 if all the elements have been moved into the queue
+ *                      (failure) -2 if failed to allocate memory for them
+ *                      (the elements which could not be moved are lost)
+*/
+int pq_ingest_destroy(PQingest *ring);
+
+
+
+
+
+/*
+ *  Publishes an element with a priority associated into the ring buffer.
+ *	Lock-free, safe to call from any number of producer threads.
+ *
+ *  Parameter:
+ *      ring        :   Pointer to a ring buffer
+ *      elem       	:   Pointer to the element to insert (can not be NULL)
+ *      priority    :   Pointer to the priority of the element (can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is published successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      (failure) -3 if the ring buffer is full (the consumer is behind)
+*/
+int pq_ingest_insert(PQingest *ring, const void *elem, const void *priority);
+
+
+
+
+
+/*
+ *  Moves all the published elements from the ring buffer into the attached queue.
+ *	Called by the consumer thread only. The pull functions below drain
+ *	the ring by themselves. An insert which is still being published stops the
+ *	drain at its cell, the elements behind it are moved by the next drain.
+ *
+ *  Parameter:
+ *      ring        :   Pointer to a ring buffer
+ *
+ *  Returns:
+ *      (int)			(success) Number of elements moved into the queue
+ *						(failure) -1 if the ring buffer is NULL
+ *                      (failure) -2 if failed to allocate memory
+ *                      (the drained elements are kept and inserted by the next drain)
+*/
+int pq_ingest_drain(PQingest *ring);
+
+
+
+
+
+/*
+ *  Drains the ring buffer, then removes the element with the lowest priority
+ *	from the attached queue, like pq_pull_minimum(). Consumer thread only.
+ *
+ *  Parameter:
+ *      ring        :   Pointer to a ring buffer
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is removed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+ *                      (failure) -2 if failed to allocate memory while draining
+*/
+int pq_ingest_pull_minimum(PQingest *ring, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Drains the ring buffer, then removes the element with the highest priority
+ *	from the attached queue, like pq_pull_maximum(). Consumer thread only.
+ *
+ *  Parameter:
+ *      ring        :   Pointer to a ring buffer
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is removed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+ *                      (failure) -2 if failed to allocate memory while draining
+*/
+int pq_ingest_pull_maximum(PQingest *ring, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Returns the number of elements the relaxed priority queue is holding.
+ *	The value may be outdated as soon as it is returned, when other threads
+ *	are modifying the queue.
+ *
+ *  Parameter:
+ *      rq       	:   Pointer to a relaxed priority queue
+ *
+ *  Returns:
+ *      (unsigned int)	Number of current elements
+*/
+#define pq_relaxed_size(rq)                 (__atomic_load_n(&(rq)->nodeCount, __ATOMIC_RELAXED))
+
+
+
+
+
+/*
+ *  Initializes the given relaxed priority queue.
+ *	Two or more heaps per thread are a good start for queueCount.
+ *
+ *  Parameter:
+ *      rq       	        :   Pointer to a relaxed priority queue to initialize
+ *      queueCount          :   Number of heaps (the relaxation, 1 gives a strict queue)
+ *      choiceCount         :   Number of heaps a pull compares (0 selects PQ_RELAXED_DEFAULT_CHOICES)
+ *      capacity            :   Initial capacity of all the heaps together
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *                              (can be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the queue is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory or to create the locks
+*/
+int pq_relaxed_init(
+    PQrelaxed *rq,
+    unsigned int queueCount,
+    unsigned int choiceCount,
+    unsigned int capacity,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Initializes the given relaxed priority queue, all the memory of which (the
+ *  heaps and the block holding them) is obtained from the specified allocator.
+ *  The heaps grow under their own locks, so the allocator must be safe to call
+ *  from several threads at once (an arena is not).
+ *  pq_relaxed_init() is equivalent to calling this function with a NULL allocator.
+ *
+ *  Parameter:
+ *      rq       	        :   Pointer to a relaxed priority queue to initialize
+ *      queueCount          :   Number of heaps (the relaxation, 1 gives a strict queue)
+ *      choiceCount         :   Number of heaps a pull compares (0 selects PQ_RELAXED_DEFAULT_CHOICES)
+ *      capacity            :   Initial capacity of all the heaps together
+ *      allocator           :   Allocator of the queue, copied into the queue
+ *                              (can be NULL for malloc(), realloc() & free())
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *                              (can be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the queue is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory or to create the locks
+*/
+int pq_relaxed_init_allocator(
+    PQrelaxed *rq,
+    unsigned int queueCount,
+    unsigned int choiceCount,
+    unsigned int capacity,
+    const PQallocator *allocator,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Destroys the given relaxed priority queue, like pq_destroy().
+ *	No other thread may use the queue during or after this call.
+ *
+ *  Parameter:
+ *      rq       	:   Pointer to a relaxed priority queue to destroy
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_relaxed_destroy(PQrelaxed *rq);
+
+
+
+
+
+/*
+ *  Inserts an element with a priority associated into a random heap of the
+ *	specified queue. Safe to call from any number of threads.
+ *
+ *  Parameter:
+ *      rq       	:   Pointer to a relaxed priority queue
+ *      elem       	:   Pointer to the element to insert (can not be NULL)
+ *      priority    :   Pointer to the priority of the element (can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is inserted successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_relaxed_insert_with_priority(PQrelaxed *rq, const void *elem, const void *priority);
+
+
+
+
+
+/*
+ *  Removes an element with one of the lowest priorities from the specified queue.
+ *	Safe to call from any number of threads.
+ *
+ *  Parameter:
+ *      rq       	:   Pointer to a relaxed priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if an element is removed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+*/
+int pq_relaxed_pull_minimum(PQrelaxed *rq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Removes an element with one of the highest priorities from the specified queue.
+ *	Safe to call from any number of threads.
+ *
+ *  Parameter:
+ *      rq       	:   Pointer to a relaxed priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if an element is removed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+*/
+int pq_relaxed_pull_maximum(PQrelaxed *rq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Sets how often a pull measures its rank error. The measurement scans every
+ *	heap of the queue, one at a time, and is only exact when no other thread
+ *	modifies the queue meanwhile.
+ *
+ *  Parameter:
+ *      rq       	:   Pointer to a relaxed priority queue
+ *      interval    :   Every interval-th pull is measured (0 turns the measurement off)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the interval is set successfully
+ *						(failure) -1 if the queue is NULL
+*/
+int pq_relaxed_set_rank_sampling(PQrelaxed *rq, unsigned int interval);
+
+
+
+
+
+/*
+ *  Copies the pull and rank error statistics of the specified queue.
+ *
+ *  Parameter:
+ *      rq       	:   Pointer to a relaxed priority queue
+ *      stats       :   Pointer to a PQrelaxedStats which receives the statistics
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the statistics are copied successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+*/
+int pq_relaxed_get_stats(PQrelaxed *rq, PQrelaxedStats *stats);
+
+
+
+
+
+#endif
+
@@ -0,0 +1,296 @@
+
+
+/************************************************************************************
+    External Memory Double Ended Priority Queue ADT
+    A bounded PriorityQueue which spills sorted runs to temporary files
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef DOUBLE_ENDED_PQ_EXTERNAL_H
+#define DOUBLE_ENDED_PQ_EXTERNAL_H
+
+
+
+
+#include "pq.h"
+
+
+
+
+
+
+
+
+/*********************************************************************************************/
+/***********************************                      ************************************/
+/***********************************    DATA STRUCTURES   ************************************/
+/***********************************                      ************************************/
+/*********************************************************************************************/
+
+
+
+
+/*
+ *  A priority queue for more elements than fit into memory. At most memoryLimit
+ *  elements are held by an in-memory PriorityQueue. When it is full, its elements
+ *  are sorted, the lowest and the highest quarter stay in memory and the middle
+ *  half is written to a temporary file as a sorted run, converted to bytes by a
+ *  PQserializer. A run is read from both of its ends, a block at a time, and the
+ *  first and the last of its elements are kept loaded, so a pull compares the
+ *  extremes of the in-memory queue and of the runs and takes the better one.
+ *  PQ_EXTERNAL_MERGE_FANOUT runs of the same level are merged into one run of
+ *  the next level (like a sequence heap), which keeps the number of runs (and
+ *  of their buffers) logarithmic in the number of elements.
+*/
+struct PQexternal_ {
+    
+    PriorityQueue queue;                    /* The in-memory part, at most memoryLimit elements */
+    unsigned int memoryLimit;               /* Number of elements the in-memory part may hold */
+    
+    struct PQexternalRun_ *pRuns;           /* The runs on disk, in no particular order */
+    unsigned int runCount;                  /* Number of runs */
+    unsigned int runCapacity;               /* Length of pRuns array */
+    size_t blockSize;                       /* Bytes read from a run at a time, at each end */
+    char *pDirectory;                       /* Directory of the run files, or NULL for tmpfile() */
+    
+    unsigned char *pRecord;                 /* Buffer in which the elements are serialized */
+    size_t recordSize;                      /* Length of pRecord buffer */
+    PQserializer serializer;                /* Converts the elements of the runs */
+    
+    unsigned long long nodeCount;           /* Number of elements in memory and in the runs */
+    unsigned long long spillCount;          /* Number of runs written by spills so far */
+    unsigned long long mergeCount;          /* Number of runs written by merges so far */
+    
+};
+typedef struct PQexternal_ PQexternal;
+
+
+#define PQ_EXTERNAL_MERGE_FANOUT            8
+#define PQ_EXTERNAL_DEFAULT_BLOCK           65536
+
+
+
+
+
+
+
+
+/*********************************************************************************************/
+/***********************************                      ************************************/
+/***********************************   PUBLIC INTERFACES  ************************************/
+/***********************************                      ************************************/
+/*********************************************************************************************/
+
+
+
+
+/*
+ *  Returns the number of elements the external priority queue is holding,
+ *	in memory and in the runs together.
+ *
+ *  Parameter:
+ *      eq       	:   Pointer to an external priority queue
+ *
+ *  Returns:
+ *      (unsigned long long)	Number of current elements
+*/
+#define pq_external_size(eq)                ((eq)->nodeCount)
+
+
+
+
+
+/*
+ *  Returns the number of runs the external priority queue has on disk.
+ *
+ *  Parameter:
+ *      eq       	:   Pointer to an external priority queue
+ *
+ *  Returns:
+ *      (unsigned int)	Number of current runs
+*/
+#define pq_external_run_count(eq)           ((eq)->runCount)
+
+
+
+
+
+/*
+ *  Initializes the given external priority queue.
+ *	PQ_ENGINE_MINMAX_HEAP is the engine of choice when the pulls alternate
+ *	between both ends. The radix and the pairing heap engines are not available,
+ *	since a spill reorders the array of the in-memory queue.
+ *	The queue owns its priorities and elements: a spilled object is destroyed
+ *	once it is written, and a pull may hand out a new object made by the load
+ *	functions, which the caller then destroys like any pulled object.
+ *
+ *  Parameter:
+ *      eq       	        :   Pointer to an external priority queue to initialize
+ *      engine              :   Storage engine of the in-memory queue
+ *		hOrientation        :	Orientation of the heap (min queue or max queue)
+ *      memoryLimit         :   Number of elements kept in memory (at least 8), the in-memory
+ *                              array is allocated once with this capacity
+ *      blockSize           :   Bytes read from a run at a time, at each of its ends
+ *                              (0 selects PQ_EXTERNAL_DEFAULT_BLOCK)
+ *      directory           :   Directory of the run files (NULL for the directory of tmpfile()),
+ *                              the files are removed as soon as they are created; where
+ *                              mkstemp() is not available (MinGW) tmpfile() is used always
+ *      serializer          :   Pointer to the four functions which save and load the priorities
+ *                              and the elements (the flat sizes must be 0)
+ *		fpComparePriority   :	Pointer to the function which will compare the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyPriority   :	Pointer to the function which will destroy the priority elements
+ *                              (can not be NULL)
+ *		fpDestroyElement    :	Pointer to the function which will destroy the elements
+ *						        (can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the queue is initialized successfully
+ *						(failure) -1 if any of the supplied parameters is invalid
+ *                      (failure) -2 if failed to allocate memory
+*/
+int pq_external_init(
+    PQexternal *eq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int memoryLimit,
+    size_t blockSize,
+    const char *directory,
+    const PQserializer *serializer,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+);
+
+
+
+
+
+/*
+ *  Destroys the given external priority queue, like pq_destroy(), and closes
+ *	(and so deletes) all of its run files.
+ *
+ *  Parameter:
+ *      eq       	:   Pointer to an external priority queue to destroy
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_external_destroy(PQexternal *eq);
+
+
+
+
+
+/*
+ *  Inserts an element with a priority associated into the specified queue,
+ *	like pq_insert_with_priority(). When the in-memory queue is full, the middle
+ *	half of it is spilled to a new run first, which may merge runs as well.
+ *
+ *  Parameter:
+ *      eq       	:   Pointer to an external priority queue
+ *      elem       	:   Pointer to the element to insert (can not be NULL)
+ *      priority    :   Pointer to the priority of the element (can not be NULL)
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is inserted successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      (failure) -2 if failed to allocate memory
+ *                      (failure) -3 if the spill could not be written (nothing is inserted)
+*/
+int pq_external_insert_with_priority(PQexternal *eq, const void *elem, const void *priority);
+
+
+
+
+
+/*
+ *  Removes the element with the lowest priority from the specified queue,
+ *	like pq_pull_minimum(), from memory or from the front of a run.
+ *
+ *  Parameter:
+ *      eq       	:   Pointer to an external priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is removed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+ *                      (failure) -3 if a run could not be read (nothing is removed)
+*/
+int pq_external_pull_minimum(PQexternal *eq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Removes the element with the highest priority from the specified queue,
+ *	like pq_pull_maximum(), from memory or from the back of a run.
+ *
+ *  Parameter:
+ *      eq       	:   Pointer to an external priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is removed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+ *                      (failure) -3 if a run could not be read (nothing is removed)
+*/
+int pq_external_pull_maximum(PQexternal *eq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Returns the element with the lowest priority without removing it,
+ *	like pq_peek_minimum().
+ *
+ *  Parameter:
+ *      eq       	:   Pointer to an external priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is accessed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+*/
+int pq_external_peek_minimum(PQexternal *eq, void **priority, void **elem);
+
+
+
+
+
+/*
+ *  Returns the element with the highest priority without removing it,
+ *	like pq_peek_maximum().
+ *
+ *  Parameter:
+ *      eq       	:   Pointer to an external priority queue
+ *      priority    :   Address of a pointer which receives the priority element
+ *      elem       	:   Address of a pointer which receives the element
+ *
+ *  Returns:
+ *      (int)			(success) 0 if the element is accessed successfully
+ *						(failure) -1 if any of the supplied parameters is NULL
+ *                      or the queue is empty
+*/
+int pq_external_peek_maximum(PQexternal *eq, void **priority, void **elem);
+
+
+
+
+
+#endif
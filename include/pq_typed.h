@@ -0,0 +1,241 @@
+
+
+/************************************************************************************
+    Type Specialized Double Ended Priority Queue ADT
+    Based on Binary Heap Data Structure (Array Based)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef DOUBLE_ENDED_PQ_TYPED_H
+#define DOUBLE_ENDED_PQ_TYPED_H
+
+
+
+
+#include "pq.h"
+#include <stdint.h>
+#include <stdlib.h>
+
+
+
+
+/*
+ *  Generates a priority queue type (name) which stores priorities of the
+ *  arithmetic type (key_type) inline in every node and compares them with
+ *  the built-in < operator, instead of calling a user compare function
+ *  through a void pointer. All operations are static inline functions,
+ *  so the sift loops are compiled together with the caller.
+ *
+ *  The queue is a single binary heap whose orientation follows the most recent
+ *  pull or peek operation: it is rebuilt in O(n) time whenever the opposite
+ *  extreme is requested. Unlike PQ_ENGINE_BINARY_HEAP, it neither tracks the
+ *  opposite extreme nor scans the leaves for it, so it suits workloads which
+ *  pull from one end at a time. The capacity doubles when the array is full,
+ *  up to PQ_CAPACITY_MAX.
+ *
+ *  Generated types:
+ *      name_node       :   Node holding (key_type priority, void *elem)
+ *      name            :   The priority queue
+ *
+ *  Generated functions (return codes follow the functions of pq.h):
+ *      int  name_init(name *pq, enum PQ_HeapOrient_t hOrientation, unsigned int capacity,
+ *                      void (*fpDestroyElement) (void *element));
+ *      void name_destroy(name *pq);
+ *      int  name_insert_with_priority(name *pq, const void *elem, key_type priority);
+ *      int  name_peek_minimum(name *pq, key_type *priority, void **elem);
+ *      int  name_peek_maximum(name *pq, key_type *priority, void **elem);
+ *      int  name_pull_minimum(name *pq, key_type *priority, void **elem);
+ *      int  name_pull_maximum(name *pq, key_type *priority, void **elem);
+ *
+ *  Parameter:
+ *      name        :   Prefix of the generated type and functions
+ *      key_type    :   Arithmetic type of the priorities
+*/
+#define PQ_DECLARE_TYPED(name, key_type)                                                    \
+                                                                                            \
+typedef struct name##_node_ {                                                               \
+    key_type priority;                                                                      \
+    void *elem;                                                                             \
+} name##_node;                                                                              \
+                                                                                            \
+typedef struct name##_ {                                                                    \
+    name##_node *pArrayNode;                                                                \
+    enum PQ_HeapOrient_t heapOrint;                                                         \
+    unsigned int nodeCount;                                                                 \
+    unsigned int arrCapacity;                                                               \
+    void (*fpDestroyElement) (void *element);                                               \
+} name;                                                                                     \
+                                                                                            \
+/* Nonzero if a belongs closer to the root than b under the given orientation */            \
+static inline int name##_before(int isMin, key_type a, key_type b) {                        \
+    return isMin != 0 ? a < b : b < a;                                                      \
+}                                                                                           \
+                                                                                            \
+/* Moves the hole at index up until node fits, then stores node there */                    \
+static inline void name##_swim(name##_node *pArray, unsigned int index,                     \
+                                name##_node node, int isMin) {                              \
+    unsigned int parent;                                                                    \
+    while (index > 0) {                                                                     \
+        parent = (index - 1) / 2;                                                           \
+        if (name##_before(isMin, node.priority, pArray[parent].priority) == 0)              \
+            break;                                                                          \
+        pArray[index] = pArray[parent];                                                     \
+        index = parent;                                                                     \
+    }                                                                                       \
+    pArray[index] = node;                                                                   \
+}                                                                                           \
+                                                                                            \
+/* Moves the hole at index down until node fits, then stores node there */                  \
+static inline void name##_sink(name##_node *pArray, unsigned int size, unsigned int index,  \
+                                name##_node node, int isMin) {                              \
+    unsigned int child;                                                                     \
+    while ((child = 2 * index + 1) < size) {                                                \
+        if (child + 1 < size &&                                                             \
+            name##_before(isMin, pArray[child + 1].priority, pArray[child].priority))       \
+            child += 1;                                                                     \
+        if (name##_before(isMin, pArray[child].priority, node.priority) == 0)               \
+            break;                                                                          \
+        pArray[index] = pArray[child];                                                      \
+        index = child;                                                                      \
+    }                                                                                       \
+    pArray[index] = node;                                                                   \
+}                                                                                           \
+                                                                                            \
+static inline void name##_orient(name *pq, enum PQ_HeapOrient_t hOrientation) {             \
+    unsigned int index;                                                                     \
+    if (pq->heapOrint == hOrientation)                                                      \
+        return;                                                                             \
+    pq->heapOrint = hOrientation;                                                           \
+    index = pq->nodeCount / 2;                                                              \
+    while (index > 0) {                                                                     \
+        index -= 1;                                                                         \
+        name##_sink(pq->pArrayNode, pq->nodeCount, index, pq->pArrayNode[index],           \
+                        hOrientation == PQ_HEAP_MIN);                                       \
+    }                                                                                       \
+}                                                                                           \
+                                                                                            \
+static inline int name##_init(name *pq, enum PQ_HeapOrient_t hOrientation,                 \
+                                unsigned int capacity,                                      \
+                                void (*fpDestroyElement) (void *element)) {                 \
+    if (pq == 0 || capacity == 0)                                                           \
+        return -1;                                                                          \
+    pq->pArrayNode = (name##_node *) malloc(capacity * sizeof(name##_node));                \
+    if (pq->pArrayNode == 0)                                                                \
+        return -2;                                                                          \
+    pq->heapOrint = hOrientation;                                                           \
+    pq->nodeCount = 0;                                                                      \
+    pq->arrCapacity = capacity;                                                             \
+    pq->fpDestroyElement = fpDestroyElement;                                                \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline void name##_destroy(name *pq) {                                               \
+    unsigned int index;                                                                     \
+    if (pq == 0)                                                                            \
+        return;                                                                             \
+    if (pq->fpDestroyElement != 0) {                                                        \
+        for (index = 0; index < pq->nodeCount; index += 1)                                  \
+            pq->fpDestroyElement(pq->pArrayNode[index].elem);                               \
+    }                                                                                       \
+    free((void *) pq->pArrayNode);                                                          \
+}                                                                                           \
+                                                                                            \
+static inline int name##_insert_with_priority(name *pq, const void *elem,                  \
+                                                key_type priority) {                        \
+    name##_node node;                                                                       \
+    name##_node *pArray;                                                                    \
+    size_t newCapacity;                                                                     \
+    if (pq == 0 || elem == 0)                                                               \
+        return -1;                                                                          \
+    if (pq->nodeCount == pq->arrCapacity) {                                                 \
+        /* The new capacity saturates at PQ_CAPACITY_MAX instead of wrapping */             \
+        if (pq->arrCapacity >= PQ_CAPACITY_MAX)                                             \
+            return -2;                                                                      \
+        newCapacity = pq->arrCapacity >                                                     \
+                        PQ_CAPACITY_MAX / PQ_DEFAULT_TYPED_EXPANSION_FACTOR ?               \
+                        (size_t) PQ_CAPACITY_MAX :                                          \
+                        (size_t) PQ_DEFAULT_TYPED_EXPANSION_FACTOR * pq->arrCapacity;       \
+        if (newCapacity > SIZE_MAX / sizeof(name##_node))                                   \
+            return -2;                                                                      \
+        pArray = (name##_node *) realloc((void *) pq->pArrayNode,                           \
+                        newCapacity * sizeof(name##_node));                                 \
+        if (pArray == 0)                                                                    \
+            return -2;                                                                      \
+        pq->pArrayNode = pArray;                                                            \
+        pq->arrCapacity = (unsigned int) newCapacity;                                       \
+    }                                                                                       \
+    node.priority = priority;                                                               \
+    node.elem = (void *) elem;                                                              \
+    pq->nodeCount += 1;                                                                     \
+    name##_swim(pq->pArrayNode, pq->nodeCount - 1, node, pq->heapOrint == PQ_HEAP_MIN);     \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline int name##_peek_extreme(name *pq, enum PQ_HeapOrient_t hOrientation,         \
+                                        key_type *priority, void **elem) {                  \
+    if (pq == 0 || priority == 0 || elem == 0 || pq->nodeCount == 0)                        \
+        return -1;                                                                          \
+    name##_orient(pq, hOrientation);                                                        \
+    *priority = pq->pArrayNode[0].priority;                                                 \
+    *elem = pq->pArrayNode[0].elem;                                                         \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline int name##_pull_extreme(name *pq, enum PQ_HeapOrient_t hOrientation,         \
+                                        key_type *priority, void **elem) {                  \
+    if (pq == 0 || priority == 0 || elem == 0 || pq->nodeCount == 0)                        \
+        return -1;                                                                          \
+    name##_orient(pq, hOrientation);                                                        \
+    *priority = pq->pArrayNode[0].priority;                                                 \
+    *elem = pq->pArrayNode[0].elem;                                                         \
+    pq->nodeCount -= 1;                                                                     \
+    if (pq->nodeCount > 0)                                                                  \
+        name##_sink(pq->pArrayNode, pq->nodeCount, 0, pq->pArrayNode[pq->nodeCount],       \
+                        hOrientation == PQ_HEAP_MIN);                                       \
+    return 0;                                                                               \
+}                                                                                           \
+                                                                                            \
+static inline int name##_peek_minimum(name *pq, key_type *priority, void **elem) {          \
+    return name##_peek_extreme(pq, PQ_HEAP_MIN, priority, elem);                            \
+}                                                                                           \
+                                                                                            \
+static inline int name##_peek_maximum(name *pq, key_type *priority, void **elem) {          \
+    return name##_peek_extreme(pq, PQ_HEAP_MAX, priority, elem);                            \
+}                                                                                           \
+                                                                                            \
+static inline int name##_pull_minimum(name *pq, key_type *priority, void **elem) {          \
+    return name##_pull_extreme(pq, PQ_HEAP_MIN, priority, elem);                            \
+}                                                                                           \
+                                                                                            \
+static inline int name##_pull_maximum(name *pq, key_type *priority, void **elem) {          \
+    return name##_pull_extreme(pq, PQ_HEAP_MAX, priority, elem);                            \
+}
+
+
+
+
+#define PQ_DEFAULT_TYPED_EXPANSION_FACTOR       2
+
+
+
+
+/*
+ *  Ready made specializations for the most common priority types:
+ *      pq_u64      :   uint64_t priorities (timestamps, sequence numbers)
+ *      pq_f64      :   double priorities (scores, distances)
+*/
+PQ_DECLARE_TYPED(pq_u64, uint64_t)
+PQ_DECLARE_TYPED(pq_f64, double)
+
+
+
+
+#endif
+
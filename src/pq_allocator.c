@@ -0,0 +1,239 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Default allocator & arena allocator
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+/*  Every block handed out by an arena starts on this boundary, which is enough
+    for PQnode and for the index buffers. The d-ary engines align their node
+    arrays to cache lines by themselves.
+*/
+#define PQ_ARENA_ALIGNMENT                  16
+#define pq_arena_round(size)                (((size) + PQ_ARENA_ALIGNMENT - 1) & \
+                                                ~((size_t) PQ_ARENA_ALIGNMENT - 1))
+
+
+
+
+/*  A chunk is a header followed by its data area. Blocks are cut from the data
+    area one after another, the most recent one can still grow or be taken back.
+*/
+struct PQarenaChunk_ {
+    
+    struct PQarenaChunk_ *pPrev;            /* Previous chunk of the same arena */
+    size_t size;                            /* Size of the data area in bytes */
+    size_t used;                            /* Bytes of the data area handed out so far */
+    size_t last;                            /* Offset of the most recent block */
+};
+
+#define pq_arena_data(pChunk)               ((unsigned char *) (pChunk) + \
+                                                pq_arena_round(sizeof(struct PQarenaChunk_)))
+
+
+
+
+
+
+static void *pq_default_alloc(void *context, size_t size) {
+    
+    (void) context;
+    return malloc(size);
+}
+
+
+
+
+
+static void *pq_default_realloc(void *context, void *block, size_t oldSize, size_t newSize) {
+    
+    (void) context;
+    (void) oldSize;
+    return realloc(block, newSize);
+}
+
+
+
+
+
+static void pq_default_free(void *context, void *block, size_t size) {
+    
+    (void) context;
+    (void) size;
+    free(block);
+}
+
+
+
+
+
+const PQallocator pq_default_allocator = {
+    pq_default_alloc,
+    pq_default_realloc,
+    pq_default_free,
+    0
+};
+
+
+
+
+
+static void *pq_arena_alloc(void *context, size_t size) {
+    
+    PQarena *arena;
+    struct PQarenaChunk_ *pChunk;
+    size_t chunkSize;
+    
+    
+    arena = (PQarena *) context;
+    size = pq_arena_round(size);
+    pChunk = arena->pChunk;
+    
+    
+    /* Start a new chunk when the current one can not hold the block */
+    /* A block larger than the chunk size gets a chunk of its own size */
+    if (pChunk == 0 || pChunk->size - pChunk->used < size) {
+        chunkSize = size > arena->chunkSize ? size : arena->chunkSize;
+        pChunk = (struct PQarenaChunk_ *) malloc(pq_arena_round(sizeof(struct PQarenaChunk_)) + chunkSize);
+        if (pChunk == 0)
+            return 0;
+        pChunk->pPrev = arena->pChunk;
+        pChunk->size = chunkSize;
+        pChunk->used = 0;
+        pChunk->last = 0;
+        arena->pChunk = pChunk;
+    }
+    
+    pChunk->last = pChunk->used;
+    pChunk->used += size;
+    
+    return (void *) (pq_arena_data(pChunk) + pChunk->last);
+}
+
+
+
+
+
+static void *pq_arena_realloc(void *context, void *block, size_t oldSize, size_t newSize) {
+    
+    PQarena *arena;
+    struct PQarenaChunk_ *pChunk;
+    void *newBlock;
+    
+    
+    arena = (PQarena *) context;
+    pChunk = arena->pChunk;
+    if (block == 0)
+        return pq_arena_alloc(context, newSize);
+    
+    
+    /* The most recent block grows (or shrinks) in place if the chunk has room */
+    if (pChunk != 0 && (unsigned char *) block == pq_arena_data(pChunk) + pChunk->last &&
+        pq_arena_round(newSize) <= pChunk->size - pChunk->last) {
+        pChunk->used = pChunk->last + pq_arena_round(newSize);
+        return block;
+    }
+    
+    
+    /* Otherwise the block moves, its old place is lost until the arena is released */
+    newBlock = pq_arena_alloc(context, newSize);
+    if (newBlock == 0)
+        return 0;
+    memcpy(newBlock, (const void *) block, oldSize < newSize ? oldSize : newSize);
+    
+    return newBlock;
+}
+
+
+
+
+
+static void pq_arena_free(void *context, void *block, size_t size) {
+    
+    PQarena *arena;
+    struct PQarenaChunk_ *pChunk;
+    
+    
+    (void) size;
+    arena = (PQarena *) context;
+    pChunk = arena->pChunk;
+    
+    
+    /* Only the most recent block can be taken back */
+    if (block != 0 && pChunk != 0 && (unsigned char *) block == pq_arena_data(pChunk) + pChunk->last)
+        pChunk->used = pChunk->last;
+    
+    return;
+}
+
+
+
+
+
+int pq_arena_init(PQarena *arena, size_t chunkSize) {
+    
+    if (arena == 0)
+        return -1;
+    
+    arena->pChunk = 0;
+    arena->chunkSize = chunkSize == 0 ? PQ_ARENA_DEFAULT_CHUNK_SIZE : pq_arena_round(chunkSize);
+    
+    return 0;
+}
+
+
+
+
+
+void pq_arena_allocator(PQarena *arena, PQallocator *allocator) {
+    
+    if (arena == 0 || allocator == 0)
+        return;
+    
+    allocator->fpAlloc = pq_arena_alloc;
+    allocator->fpRealloc = pq_arena_realloc;
+    allocator->fpFree = pq_arena_free;
+    allocator->context = (void *) arena;
+    
+    return;
+}
+
+
+
+
+
+void pq_arena_release(PQarena *arena) {
+    
+    struct PQarenaChunk_ *pChunk, *pPrev;
+    
+    
+    if (arena == 0)
+        return;
+    
+    pChunk = arena->pChunk;
+    while (pChunk != 0) {
+        pPrev = pChunk->pPrev;
+        free((void *) pChunk);
+        pChunk = pPrev;
+    }
+    arena->pChunk = 0;
+    
+    return;
+}
+
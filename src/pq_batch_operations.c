@@ -0,0 +1,625 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Batch (bulk) operations
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+#include <stdlib.h>
+
+
+
+
+
+
+
+
+/*  Grow the internal array only once, by as many steps of the
+    growth percent as it takes to hold count more nodes.
+*/
+static int pq_batch_grow(PriorityQueue *pq, unsigned int count) {
+    
+    unsigned int newSize, newCapacity;
+    
+    newSize = pq_size(pq) + count;
+    if (newSize < pq_size(pq) || newSize > PQ_CAPACITY_MAX)
+        return -2;
+    if (newSize > pq_capacity(pq)) {
+        newCapacity = pq_next_capacity(pq, pq_capacity(pq), newSize);
+        if (pq_resize_capacity(pq, newCapacity) != 0)
+            return -2;
+    }
+    
+    return 0;
+}
+
+
+
+
+
+void pq_batch_settle(PriorityQueue *pq, unsigned int oldSize) {
+    
+    unsigned int index, newSize, count;
+    int isRebuild;
+    
+    
+    newSize = pq_size(pq);
+    count = newSize - oldSize;
+    
+    /* A radix heap places every new node into its bucket, in O(1) amortized time each */
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP) {
+        for (index = oldSize; index < newSize; index += 1) {
+            pq_size(pq) = index + 1;
+            pq_radix_push(pq, index);
+        }
+        return;
+    }
+    
+    
+    /* A pairing heap links every new node with its root, in O(1) time each */
+    if (pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP) {
+        for (index = oldSize; index < newSize; index += 1) {
+            pq_size(pq) = index + 1;
+            pq_pheap_push(pq, index);
+        }
+        return;
+    }
+    
+    
+    /*  Moving each new node up costs about log(n) comparisons per node,
+        rebuilding the whole heap bottom-up costs about 2n comparisons.
+        Rebuild when the batch is large compared to the resulting heap.
+    */
+    isRebuild = (unsigned long long) count * (pq_log2(newSize) + 1) > 2 * (unsigned long long) newSize ? 1 : 0;
+    
+    if (isRebuild == 1) {
+        pq_opposite_forget(pq);
+        if (pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP)
+            pq_mmheap_build(pq);
+        else if (pq_heap_orientation(pq) == PQ_HEAP_MIN)
+            pq_bheap_build_minheap(pq);
+        else
+            pq_bheap_build_maxheap(pq);
+        return;
+    }
+    
+    /* The opposite extreme is tracked as if the nodes were inserted one by one */
+    for (index = oldSize; index < newSize; index += 1) {
+        pq_size(pq) = index + 1;
+        if (pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP)
+            pq_mmheap_push_up(pq, index);
+        else if (pq_heap_orientation(pq) == PQ_HEAP_MIN)
+            pq_bheap_opposite_track(pq, pq_bheap_swim_light(pq, index));
+        else
+            pq_bheap_opposite_track(pq, pq_bheap_swim_heavy(pq, index));
+    }
+    
+    return;
+}
+
+
+
+
+
+int pq_insert_batch(PriorityQueue *pq, const void **elems, const void **priorities, unsigned int count) {
+    
+    PQnode *pNode;
+    unsigned int index, oldSize;
+    
+    
+    /* Check for invalid function arguments */
+    /* Nothing is inserted unless every element is valid */
+    if (pq == 0 || elems == 0 || priorities == 0)
+        return -1;
+    if (pq_is_oriented(pq) &&
+        pq_heap_orientation(pq) != PQ_HEAP_MIN && pq_heap_orientation(pq) != PQ_HEAP_MAX)
+        return -1;
+    for (index = 0; index < count; index += 1) {
+        if (elems[index] == 0 || priorities[index] == 0)
+            return -1;
+    }
+    if (count == 0)
+        return 0;
+    
+    
+    if (pq_batch_grow(pq, count) != 0)
+        return -2;
+    
+    /* A radix heap falls back to a binary heap before it takes a key below its last minimum */
+    /* Only once the array has grown, so that a failed growth leaves the engine as it was */
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP) {
+        for (index = 0; index < count; index += 1) {
+            if (pq->fpPriorityKey(priorities[index]) < pq->radixLast) {
+                pq_radix_fallback(pq);
+                break;
+            }
+        }
+    }
+    
+    
+    /* Append all the new nodes after the existing ones */
+    oldSize = pq_size(pq);
+    for (index = 0; index < count; index += 1) {
+        pNode = pq_array(pq) + oldSize + index;
+        pNode->priority = (void *) priorities[index];
+        pNode->elem = (void *) elems[index];
+        pq_handle_acquire(pq, oldSize + index, 0);
+    }
+    pq_size(pq) = oldSize + count;
+    
+    pq_batch_settle(pq, oldSize);
+    
+    return 0;
+}
+
+
+
+
+
+int pq_merge(PriorityQueue *dst, PriorityQueue *src) {
+    
+    unsigned int index, oldSize, count;
+    
+    
+    /* Check for invalid function arguments */
+    /* Both queues must order their priorities by the same compare function */
+    if (dst == 0 || src == 0 || dst == src)
+        return -1;
+    if (dst->fpComparePriority != src->fpComparePriority)
+        return -1;
+    if (pq_is_oriented(dst) &&
+        pq_heap_orientation(dst) != PQ_HEAP_MIN && pq_heap_orientation(dst) != PQ_HEAP_MAX)
+        return -1;
+    
+    /* Nodes loaded from a snapshot may point into its mapping, which goes along with them */
+    /* The destination can not hold a mapping of its own, nor destroy what lives in this one */
+    if (src->pSnapshotMap != 0 &&
+        (dst->pSnapshotMap != 0 || dst->fpDestroyPriority != src->fpDestroyPriority ||
+         dst->fpDestroyElement != src->fpDestroyElement))
+        return -1;
+    count = pq_size(src);
+    if (count == 0)
+        return 0;
+    
+    
+    if (pq_batch_grow(dst, count) != 0)
+        return -2;
+    
+    /* A radix heap falls back to a binary heap before it takes a key below its last minimum */
+    /* Only once the array has grown, so that a failed growth leaves the engine as it was */
+    if (pq_engine(dst) == PQ_ENGINE_RADIX_HEAP) {
+        for (index = 0; index < count; index += 1) {
+            if (dst->fpPriorityKey(pq_array(src)[index].priority) < dst->radixLast) {
+                pq_radix_fallback(dst);
+                break;
+            }
+        }
+    }
+    
+    
+    /* The nodes of the source move to the end of the destination, without their handles */
+    oldSize = pq_size(dst);
+    for (index = 0; index < count; index += 1) {
+        pq_array(dst)[oldSize + index] = pq_array(src)[index];
+        pq_handle_acquire(dst, oldSize + index, 0);
+    }
+    pq_size(dst) = oldSize + count;
+    
+    /* Two pairing heaps of the same orientation are melded by linking their roots */
+    if (pq_engine(dst) == PQ_ENGINE_PAIRING_HEAP && pq_engine(src) == PQ_ENGINE_PAIRING_HEAP &&
+        pq_heap_orientation(dst) == pq_heap_orientation(src))
+        pq_pheap_meld(dst, src, oldSize);
+    else
+        pq_batch_settle(dst, oldSize);
+    
+    
+    /* The source is left empty, as if all of its nodes had been pulled */
+    pq_release_all(src);
+    if (src->pSnapshotMap != 0) {
+        dst->pSnapshotMap = src->pSnapshotMap;
+        dst->snapshotMapSize = src->snapshotMapSize;
+        src->pSnapshotMap = 0;
+        src->snapshotMapSize = 0;
+    }
+    
+    return 0;
+}
+
+
+
+
+
+/*  Pull count nodes from one end of the queue into the caller's arrays.
+    The heap is already oriented towards that end (binary heap engine).
+*/
+static void pq_pull_batch(
+    PriorityQueue *pq,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int count,
+    void **priorities,
+    void **elems
+)
+{
+    
+    PQnode *pNode;
+    unsigned int index, taken;
+    
+    
+    for (taken = 0; taken < count; taken += 1) {
+        
+        /* Locate the extreme node of the requested end */
+        index = 0;
+        if (pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP && hOrientation == PQ_HEAP_MAX)
+            index = pq_mmheap_max_index(pq);
+        
+        pNode = pq_array(pq) + index;
+        priorities[taken] = pNode->priority;
+        elems[taken] = pNode->elem;
+        pq_handle_release(pq, index);
+        pq_size(pq) = pq_size(pq) - 1;
+        
+        if (index == pq_size(pq))
+            continue;
+        
+        
+        /* The last node fills the hole and moves down */
+        pq_move_node(pq, index, pq_size(pq));
+        if (pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP)
+            pq_mmheap_restore(pq, index);
+        else if (hOrientation == PQ_HEAP_MIN)
+            pq_bheap_sink_heavy(pq, index);
+        else
+            pq_bheap_sink_light(pq, index);
+    }
+    
+    
+    pq_opposite_forget(pq);
+    pq->oppositePulls = 0;
+    
+    
+    /* Shrink once for the whole batch */
+    if (pq_should_shrink(pq))
+        pq_shrink_capacity(pq);
+    
+    return;
+}
+
+
+
+
+
+int pq_pull_min_k(PriorityQueue *pq, unsigned int k, void **priorities, void **elems) {
+    
+    unsigned int count, index;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priorities == 0 || elems == 0)
+        return -1;
+    
+    count = k < pq_size(pq) ? k : pq_size(pq);
+    if (count == 0)
+        return 0;
+    
+    
+    /* Radix & pairing heaps have no array heap to pull from in bulk, they pull one by one */
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP || pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP) {
+        for (index = 0; index < count; index += 1)
+            pq_pull_minimum(pq, priorities + index, elems + index);
+        return (int) count;
+    }
+    
+    
+    /* Detect which Heap Orientation this PQ is currently configured to */
+    /* If current Heap Orientation is a MAX HEAP, transform it to a MIN HEAP once, */
+    /* Unless so few nodes are requested that pulling them one by one is cheaper */
+    if (pq_is_oriented(pq) && pq_heap_orientation(pq) == PQ_HEAP_MAX) {
+        if (count < PQ_REORIENT_PULLS) {
+            for (index = 0; index < count; index += 1)
+                pq_pull_minimum(pq, priorities + index, elems + index);
+            return (int) count;
+        }
+        pq_bheap_orient(pq, PQ_HEAP_MIN);
+    }
+    
+    pq_pull_batch(pq, PQ_HEAP_MIN, count, priorities, elems);
+    return (int) count;
+}
+
+
+
+
+
+int pq_pull_max_k(PriorityQueue *pq, unsigned int k, void **priorities, void **elems) {
+    
+    unsigned int count, index;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priorities == 0 || elems == 0)
+        return -1;
+    
+    count = k < pq_size(pq) ? k : pq_size(pq);
+    if (count == 0)
+        return 0;
+    
+    
+    /* Radix & pairing heaps have no array heap to pull from in bulk, they pull one by one */
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP || pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP) {
+        for (index = 0; index < count; index += 1)
+            pq_pull_maximum(pq, priorities + index, elems + index);
+        return (int) count;
+    }
+    
+    
+    /* Detect which Heap Orientation this PQ is currently configured to */
+    /* If current Heap Orientation is a MIN HEAP, transform it to a MAX HEAP once, */
+    /* Unless so few nodes are requested that pulling them one by one is cheaper */
+    if (pq_is_oriented(pq) && pq_heap_orientation(pq) == PQ_HEAP_MIN) {
+        if (count < PQ_REORIENT_PULLS) {
+            for (index = 0; index < count; index += 1)
+                pq_pull_maximum(pq, priorities + index, elems + index);
+            return (int) count;
+        }
+        pq_bheap_orient(pq, PQ_HEAP_MAX);
+    }
+    
+    pq_pull_batch(pq, PQ_HEAP_MAX, count, priorities, elems);
+    return (int) count;
+}
+
+
+
+
+
+/*  A small binary heap of indices into the PQnode array, ordered by the
+    priorities of the nodes they refer to. direction is 1 when the smallest
+    priority is on top and -1 when the largest priority is on top.
+*/
+struct PQfrontier_ {
+    
+    unsigned int *pIndex;
+    unsigned int size;
+    int direction;
+    
+};
+
+
+
+
+
+static int pq_frontier_before(PriorityQueue *pq, struct PQfrontier_ *frontier, unsigned int i, unsigned int j) {
+    
+    return frontier->direction *
+            pq_compare_node(pq, pq_array(pq) + frontier->pIndex[i], pq_array(pq) + frontier->pIndex[j]) < 0;
+}
+
+
+
+
+
+static void pq_frontier_swap(struct PQfrontier_ *frontier, unsigned int i, unsigned int j) {
+    
+    unsigned int temp;
+    
+    temp = frontier->pIndex[i];
+    frontier->pIndex[i] = frontier->pIndex[j];
+    frontier->pIndex[j] = temp;
+    
+    return;
+}
+
+
+
+
+
+static void pq_frontier_push(PriorityQueue *pq, struct PQfrontier_ *frontier, unsigned int nodeIndex) {
+    
+    unsigned int index, parent;
+    
+    
+    index = frontier->size;
+    frontier->pIndex[index] = nodeIndex;
+    frontier->size += 1;
+    
+    while (index > 0) {
+        parent = pq_parent_index(index, 1);
+        if (pq_frontier_before(pq, frontier, index, parent) == 0)
+            break;
+        pq_frontier_swap(frontier, index, parent);
+        index = parent;
+    }
+    
+    return;
+}
+
+
+
+
+
+static unsigned int pq_frontier_pop(PriorityQueue *pq, struct PQfrontier_ *frontier) {
+    
+    unsigned int top, index, child;
+    
+    
+    top = frontier->pIndex[0];
+    frontier->size -= 1;
+    frontier->pIndex[0] = frontier->pIndex[frontier->size];
+    
+    index = 0;
+    while ((child = pq_firstchild_index(index, 1)) < frontier->size) {
+        if (child + 1 < frontier->size && pq_frontier_before(pq, frontier, child + 1, child) == 1)
+            child += 1;
+        if (pq_frontier_before(pq, frontier, child, index) == 0)
+            break;
+        pq_frontier_swap(frontier, index, child);
+        index = child;
+    }
+    
+    return top;
+}
+
+
+
+
+
+/*  The heap is oriented against the requested end (or is a radix or pairing heap), its structure does not help.
+    Keep the best count nodes seen so far in a frontier whose top is the worst
+    of them, then hand them out from the best to the worst.
+*/
+static int pq_peek_select(
+    PriorityQueue *pq,
+    int direction,
+    unsigned int count,
+    void **priorities,
+    void **elems
+)
+{
+    
+    struct PQfrontier_ frontier;
+    unsigned int index, nodeIndex;
+    PQnode *pNode;
+    
+    
+    frontier.pIndex = (unsigned int *) pq_mem_alloc(pq, (count + 1) * sizeof(unsigned int));
+    if (frontier.pIndex == 0)
+        return -2;
+    frontier.size = 0;
+    frontier.direction = -direction;
+    
+    for (index = 0; index < pq_size(pq); index += 1) {
+        pq_frontier_push(pq, &frontier, index);
+        if (frontier.size > count)
+            pq_frontier_pop(pq, &frontier);
+    }
+    
+    while (frontier.size > 0) {
+        nodeIndex = pq_frontier_pop(pq, &frontier);
+        pNode = pq_array(pq) + nodeIndex;
+        priorities[frontier.size] = pNode->priority;
+        elems[frontier.size] = pNode->elem;
+    }
+    
+    pq_mem_free(pq, (void *) frontier.pIndex, (count + 1) * sizeof(unsigned int));
+    return (int) count;
+}
+
+
+
+
+
+static int pq_peek_batch(
+    PriorityQueue *pq,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int k,
+    void **priorities,
+    void **elems
+)
+{
+    
+    struct PQfrontier_ frontier;
+    unsigned int count, capacity, taken;
+    unsigned int nodeIndex, child, last, fanout;
+    int direction, isMinMax;
+    PQnode *pNode;
+    
+    
+    count = k < pq_size(pq) ? k : pq_size(pq);
+    if (count == 0)
+        return 0;
+    
+    direction = hOrientation == PQ_HEAP_MIN ? 1 : -1;
+    isMinMax = pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP ? 1 : 0;
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP || pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP ||
+        (isMinMax == 0 && pq_heap_orientation(pq) != hOrientation))
+        return pq_peek_select(pq, direction, count, priorities, elems);
+    
+    
+    /*  Every popped node adds at most its d children (binary & d-ary heaps),
+        or its 2 children and 4 grandchildren (Min-Max heap) to the frontier.
+        No node is added twice, so the frontier never exceeds the queue.
+    */
+    fanout = isMinMax == 1 ? 6 : pq_heap_arity(pq);
+    capacity = count < pq_size(pq) / fanout ? fanout * count + 3 : pq_size(pq);
+    frontier.pIndex = (unsigned int *) pq_mem_alloc(pq, capacity * sizeof(unsigned int));
+    if (frontier.pIndex == 0)
+        return -2;
+    frontier.size = 0;
+    frontier.direction = direction;
+    
+    
+    /*  In a Min-Max heap every node is bounded by its nearest ancestor on a level
+        of the requested kind: its parent if it is on the opposite kind of level,
+        otherwise its grandparent. The nodes without such an ancestor (the root,
+        and the first max level when looking for maximums) start the walk.
+    */
+    pq_frontier_push(pq, &frontier, 0);
+    if (isMinMax == 1 && hOrientation == PQ_HEAP_MAX) {
+        for (child = 1; child <= 2 && child < pq_size(pq); child += 1)
+            pq_frontier_push(pq, &frontier, child);
+    }
+    
+    for (taken = 0; taken < count; taken += 1) {
+        nodeIndex = pq_frontier_pop(pq, &frontier);
+        pNode = pq_array(pq) + nodeIndex;
+        priorities[taken] = pNode->priority;
+        elems[taken] = pNode->elem;
+        
+        if (isMinMax == 1 && pq_mmheap_is_min_level(nodeIndex) != (direction == 1 ? 1 : 0))
+            continue;
+        
+        child = pq_firstchild_index(nodeIndex, pq->heapArityShift);
+        last = child + pq_heap_arity(pq);
+        for (; child < last && child < pq_size(pq); child += 1)
+            pq_frontier_push(pq, &frontier, child);
+        
+        if (isMinMax == 0)
+            continue;
+        
+        child = 4 * nodeIndex + 3;
+        last = child + 4;
+        for (; child < last && child < pq_size(pq); child += 1)
+            pq_frontier_push(pq, &frontier, child);
+    }
+    
+    pq_mem_free(pq, (void *) frontier.pIndex, capacity * sizeof(unsigned int));
+    return (int) count;
+}
+
+
+
+
+
+int pq_peek_min_k(PriorityQueue *pq, unsigned int k, void **priorities, void **elems) {
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priorities == 0 || elems == 0)
+        return -1;
+    
+    return pq_peek_batch(pq, PQ_HEAP_MIN, k, priorities, elems);
+}
+
+
+
+
+
+int pq_peek_max_k(PriorityQueue *pq, unsigned int k, void **priorities, void **elems) {
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priorities == 0 || elems == 0)
+        return -1;
+    
+    return pq_peek_batch(pq, PQ_HEAP_MAX, k, priorities, elems);
+}
+
+
@@ -0,0 +1,85 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Capacity management (growth policy, reserve & shrink)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+
+
+
+
+int pq_set_growth_policy(PriorityQueue *pq, unsigned int growthPercent, unsigned int shrinkPercent) {
+    
+    /* Check for invalid function arguments */
+    /* Without the gap between both percentages a shrunk array would be full at once */
+    if (pq == 0 || growthPercent <= 100 || shrinkPercent >= 100)
+        return -1;
+    if ((unsigned long long) growthPercent * shrinkPercent >= 10000)
+        return -1;
+    
+    pq->growthPercent = growthPercent;
+    pq->shrinkPercent = shrinkPercent;
+    pq->shrinkBelow = pq_capacity(pq) <= pq->minCapacity ? 0 :
+                        (unsigned int) ((size_t) pq_capacity(pq) * shrinkPercent / 100);
+    
+    return 0;
+}
+
+
+
+
+
+int pq_reserve(PriorityQueue *pq, size_t capacity) {
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || capacity > PQ_CAPACITY_MAX)
+        return -1;
+    
+    
+    if (capacity > pq_capacity(pq)) {
+        if (pq_resize_capacity(pq, (unsigned int) capacity) != 0)
+            return -2;
+    }
+    
+    /* The reserved capacity becomes the floor of automatic shrinking once it is in place */
+    if (capacity > pq->minCapacity)
+        pq->minCapacity = (unsigned int) capacity;
+    
+    if (pq_capacity(pq) <= pq->minCapacity)
+        pq->shrinkBelow = 0;
+    
+    return 0;
+}
+
+
+
+
+
+int pq_shrink_to_fit(PriorityQueue *pq) {
+    
+    unsigned int capacity;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0)
+        return -1;
+    
+    capacity = pq_size(pq) == 0 ? 1 : pq_size(pq);
+    pq->minCapacity = capacity;
+    if (pq_resize_capacity(pq, capacity) != 0)
+        return -2;
+    
+    return 0;
+}
+
@@ -0,0 +1,380 @@
+
+
+/************************************************************************************
+    Implementation of Thread Safe Double Ended Priority Queue ADT
+    Flat combining over a PriorityQueue
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "pq.h"
+#include "pq_concurrent.h"
+#include "pq_internal.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+
+
+
+
+/* Life cycle of a publication slot */
+#define PQ_SLOT_FREE                        0
+#define PQ_SLOT_CLAIMED                     1       /* A thread is writing its request */
+#define PQ_SLOT_PENDING                     2       /* The request waits for a combiner */
+#define PQ_SLOT_DONE                        3       /* The result waits for the requesting thread */
+
+
+/* Operations which can be published */
+#define PQ_OP_INSERT                        0
+#define PQ_OP_PULL_MIN                      1
+#define PQ_OP_PULL_MAX                      2
+#define PQ_OP_PEEK_MIN                      3
+#define PQ_OP_PEEK_MAX                      4
+
+
+/* Number of polls of a slot before a waiting thread yields its processor */
+#define PQ_CONCURRENT_SPIN_COUNT            64
+
+
+/*  Every slot fills a cache line of its own, so the threads do not share lines.
+    The pointers come first, so that no alignment padding hides between the fields.
+*/
+#define PQ_SLOT_PAYLOAD                     (2 * sizeof(void *) + 3 * sizeof(int))
+
+struct PQcombineSlot_ {
+    
+    void *priority;                         /* Priority to insert, or the one pulled / peeked */
+    void *elem;                             /* Element to insert, or the one pulled / peeked */
+    int state;                              /* PQ_SLOT_xxx, accessed atomically */
+    int operation;                          /* PQ_OP_xxx */
+    int result;                             /* Return value of the operation */
+    unsigned char padding[PQ_CACHE_LINE_SIZE - PQ_SLOT_PAYLOAD];
+};
+
+/* Does not compile unless a slot is exactly one cache line */
+typedef char pq_combine_slot_size_check[sizeof(struct PQcombineSlot_) == PQ_CACHE_LINE_SIZE ? 1 : -1];
+
+/* Sizes of the slot block (with room for its alignment) and of one batch array */
+#define pq_slot_block_size(slotCount)       ((size_t) (slotCount) * sizeof(struct PQcombineSlot_) + \
+                                             PQ_CACHE_LINE_SIZE)
+#define pq_batch_size(slotCount, type)      ((size_t) (slotCount) * sizeof(type))
+
+
+
+
+
+
+/*  Execute every pending operation. The inserts are collected first and loaded
+    as one batch, which is a valid order since all of them are in progress at the
+    same time as the other pending operations.
+*/
+static void pq_concurrent_combine(PQconcurrent *cq) {
+    
+    struct PQcombineSlot_ *pSlot;
+    unsigned int index, batchCount;
+    int result;
+    
+    
+    batchCount = 0;
+    for (index = 0; index < cq->slotCount; index += 1) {
+        pSlot = cq->pSlots + index;
+        if (__atomic_load_n(&pSlot->state, __ATOMIC_ACQUIRE) == PQ_SLOT_PENDING &&
+            pSlot->operation == PQ_OP_INSERT) {
+            cq->pBatchElem[batchCount] = pSlot->elem;
+            cq->pBatchPriority[batchCount] = pSlot->priority;
+            cq->pBatchSlot[batchCount] = index;
+            batchCount += 1;
+        }
+    }
+    
+    if (batchCount > 0) {
+        result = pq_insert_batch(&cq->queue, cq->pBatchElem, cq->pBatchPriority, batchCount);
+        for (index = 0; index < batchCount; index += 1) {
+            pSlot = cq->pSlots + cq->pBatchSlot[index];
+            pSlot->result = result;
+            __atomic_store_n(&pSlot->state, PQ_SLOT_DONE, __ATOMIC_RELEASE);
+        }
+    }
+    
+    
+    /* The remaining requests, including inserts published during this pass */
+    for (index = 0; index < cq->slotCount; index += 1) {
+        pSlot = cq->pSlots + index;
+        if (__atomic_load_n(&pSlot->state, __ATOMIC_ACQUIRE) != PQ_SLOT_PENDING)
+            continue;
+        switch (pSlot->operation) {
+            case PQ_OP_INSERT:
+                result = pq_insert_with_priority(&cq->queue, pSlot->elem, pSlot->priority);
+                break;
+            case PQ_OP_PULL_MIN:
+                result = pq_pull_minimum(&cq->queue, &pSlot->priority, &pSlot->elem);
+                break;
+            case PQ_OP_PULL_MAX:
+                result = pq_pull_maximum(&cq->queue, &pSlot->priority, &pSlot->elem);
+                break;
+            case PQ_OP_PEEK_MIN:
+                result = pq_peek_minimum(&cq->queue, &pSlot->priority, &pSlot->elem);
+                break;
+            case PQ_OP_PEEK_MAX:
+                result = pq_peek_maximum(&cq->queue, &pSlot->priority, &pSlot->elem);
+                break;
+            default:
+                result = -1;
+        }
+        pSlot->result = result;
+        __atomic_store_n(&pSlot->state, PQ_SLOT_DONE, __ATOMIC_RELEASE);
+    }
+    
+    __atomic_store_n(&cq->nodeCount, pq_size(&cq->queue), __ATOMIC_RELAXED);
+    return;
+}
+
+
+
+
+
+/*  Combine if no other thread is combining at the moment.
+    Returns nonzero if this thread has combined.
+*/
+static int pq_concurrent_try_combine(PQconcurrent *cq) {
+    
+    if (pthread_mutex_trylock(&cq->combinerLock) != 0)
+        return 0;
+    
+    pq_concurrent_combine(cq);
+    pthread_mutex_unlock(&cq->combinerLock);
+    
+    return 1;
+}
+
+
+
+
+
+/*  Give the publication slots and the batch arrays back to the allocator of the
+    queue. Arrays which were never allocated are skipped.
+*/
+static void pq_concurrent_release(PQconcurrent *cq) {
+    
+    if (cq->pSlotBlock != 0)
+        pq_mem_free(&cq->queue, cq->pSlotBlock, pq_slot_block_size(cq->slotCount));
+    if (cq->pBatchElem != 0)
+        pq_mem_free(&cq->queue, (void *) cq->pBatchElem, pq_batch_size(cq->slotCount, void *));
+    if (cq->pBatchPriority != 0)
+        pq_mem_free(&cq->queue, (void *) cq->pBatchPriority, pq_batch_size(cq->slotCount, void *));
+    if (cq->pBatchSlot != 0)
+        pq_mem_free(&cq->queue, (void *) cq->pBatchSlot, pq_batch_size(cq->slotCount, unsigned int));
+    
+    return;
+}
+
+
+
+
+
+static int pq_concurrent_execute(PQconcurrent *cq, int operation, void **priority, void **elem) {
+    
+    struct PQcombineSlot_ *pSlot;
+    unsigned int index, start, spin;
+    int expected, result;
+    
+    
+    /*  Claim a free slot. Threads start searching at different slots (derived
+        from the address of their stack) to avoid fighting over the first ones.
+        If all the slots are taken, help the combiner to empty them.
+    */
+    start = (unsigned int) (((uintptr_t) &index >> 6) % cq->slotCount);
+    pSlot = 0;
+    while (pSlot == 0) {
+        for (index = 0; index < cq->slotCount && pSlot == 0; index += 1) {
+            pSlot = cq->pSlots + (start + index) % cq->slotCount;
+            expected = PQ_SLOT_FREE;
+            if (__atomic_load_n(&pSlot->state, __ATOMIC_RELAXED) != PQ_SLOT_FREE ||
+                __atomic_compare_exchange_n(&pSlot->state, &expected, PQ_SLOT_CLAIMED, 0,
+                                            __ATOMIC_ACQUIRE, __ATOMIC_RELAXED) == 0)
+                pSlot = 0;
+        }
+        if (pSlot == 0 && pq_concurrent_try_combine(cq) == 0)
+            sched_yield();
+    }
+    
+    
+    /* Publish the request */
+    pSlot->operation = operation;
+    pSlot->priority = *priority;
+    pSlot->elem = *elem;
+    __atomic_store_n(&pSlot->state, PQ_SLOT_PENDING, __ATOMIC_RELEASE);
+    
+    
+    /* Wait for a combiner, or become the combiner */
+    spin = 0;
+    while (__atomic_load_n(&pSlot->state, __ATOMIC_ACQUIRE) != PQ_SLOT_DONE) {
+        if (pq_concurrent_try_combine(cq) != 0)
+            continue;
+        spin += 1;
+        if (spin % PQ_CONCURRENT_SPIN_COUNT == 0)
+            sched_yield();
+    }
+    
+    
+    /* Collect the result and give the slot back */
+    result = pSlot->result;
+    *priority = pSlot->priority;
+    *elem = pSlot->elem;
+    __atomic_store_n(&pSlot->state, PQ_SLOT_FREE, __ATOMIC_RELEASE);
+    
+    return result;
+}
+
+
+
+
+
+int pq_concurrent_init(
+    PQconcurrent *cq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int capacity,
+    unsigned int slotCount,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    uintptr_t address;
+    unsigned int index;
+    int opInit;
+    
+    
+    /* Check for invalid function arguments */
+    if (cq == 0)
+        return -1;
+    if (slotCount == 0)
+        slotCount = PQ_CONCURRENT_DEFAULT_SLOTS;
+    
+    opInit = pq_init_engine(&cq->queue, engine, hOrientation, capacity,
+                            fpComparePriority, fpDestroyPriority, fpDestroyElement);
+    if (opInit != 0)
+        return opInit;
+    
+    
+    /* The publication array starts on a cache line boundary */
+    cq->slotCount = slotCount;
+    cq->nodeCount = 0;
+    cq->pSlotBlock = pq_mem_alloc(&cq->queue, pq_slot_block_size(slotCount));
+    cq->pBatchElem = (const void **) pq_mem_alloc(&cq->queue, pq_batch_size(slotCount, void *));
+    cq->pBatchPriority = (const void **) pq_mem_alloc(&cq->queue, pq_batch_size(slotCount, void *));
+    cq->pBatchSlot = (unsigned int *) pq_mem_alloc(&cq->queue, pq_batch_size(slotCount, unsigned int));
+    if (cq->pSlotBlock == 0 || cq->pBatchElem == 0 || cq->pBatchPriority == 0 || cq->pBatchSlot == 0)
+        goto INIT_FAILED;
+    
+    address = ((uintptr_t) cq->pSlotBlock + PQ_CACHE_LINE_SIZE - 1) & ~((uintptr_t) PQ_CACHE_LINE_SIZE - 1);
+    cq->pSlots = (struct PQcombineSlot_ *) address;
+    for (index = 0; index < slotCount; index += 1)
+        cq->pSlots[index].state = PQ_SLOT_FREE;
+    
+    if (pthread_mutex_init(&cq->combinerLock, 0) != 0)
+        goto INIT_FAILED;
+    
+    return 0;
+    
+    
+    INIT_FAILED:
+    pq_concurrent_release(cq);
+    pq_destroy(&cq->queue);
+    return -2;
+}
+
+
+
+
+
+void pq_concurrent_destroy(PQconcurrent *cq) {
+    
+    /* Check for invalid function arguments */
+    if (cq == 0)
+        return;
+    
+    pthread_mutex_destroy(&cq->combinerLock);
+    pq_concurrent_release(cq);
+    pq_destroy(&cq->queue);
+    
+    return;
+}
+
+
+
+
+
+int pq_concurrent_insert_with_priority(PQconcurrent *cq, const void *elem, const void *priority) {
+    
+    void *pElem, *pPriority;
+    
+    
+    /* Check for invalid function arguments */
+    /* An invalid insert must not spoil the batch it would be part of */
+    if (cq == 0 || elem == 0 || priority == 0)
+        return -1;
+    
+    pElem = (void *) elem;
+    pPriority = (void *) priority;
+    return pq_concurrent_execute(cq, PQ_OP_INSERT, &pPriority, &pElem);
+}
+
+
+
+
+
+int pq_concurrent_pull_minimum(PQconcurrent *cq, void **priority, void **elem) {
+    
+    if (cq == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    return pq_concurrent_execute(cq, PQ_OP_PULL_MIN, priority, elem);
+}
+
+
+
+
+
+int pq_concurrent_pull_maximum(PQconcurrent *cq, void **priority, void **elem) {
+    
+    if (cq == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    return pq_concurrent_execute(cq, PQ_OP_PULL_MAX, priority, elem);
+}
+
+
+
+
+
+int pq_concurrent_peek_minimum(PQconcurrent *cq, void **priority, void **elem) {
+    
+    if (cq == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    return pq_concurrent_execute(cq, PQ_OP_PEEK_MIN, priority, elem);
+}
+
+
+
+
+
+int pq_concurrent_peek_maximum(PQconcurrent *cq, void **priority, void **elem) {
+    
+    if (cq == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    return pq_concurrent_execute(cq, PQ_OP_PEEK_MAX, priority, elem);
+}
+
@@ -0,0 +1,941 @@
+
+
+/************************************************************************************
+    Implementation of External Memory Double Ended Priority Queue ADT
+    A bounded PriorityQueue which spills sorted runs to temporary files
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "pq.h"
+#include "pq_external.h"
+#include "pq_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+
+
+/* Runs are read with pread() and named by mkstemp() where they exist, with fread() elsewhere (MinGW) */
+#if defined(__unix__) || defined(__APPLE__)
+#define PQ_EXTERNAL_POSIX
+#include <unistd.h>
+#endif
+
+
+
+
+#define PQ_EXTERNAL_RECORD_BUFFER           256u
+#define PQ_EXTERNAL_RUN_NAME                "/pq-run-XXXXXX"
+#define PQ_EXTERNAL_SIZES                   (2 * sizeof(unsigned int))
+#define pq_external_align(size)             (((size) + 7) & ~(size_t) 7)
+#define pq_external_record_size(sizes)      (2 * PQ_EXTERNAL_SIZES + pq_external_align((size_t) (sizes)[0]) + \
+                                                pq_external_align((size_t) (sizes)[1]))
+
+
+
+
+/*  A record of a run holds the sizes of the priority and of the element, their
+    bytes (each padded to a multiple of 8) and the two sizes once more, so that
+    the run can be read from its back as well as from its front. The records
+    of a run are sorted by their priorities in ascending order.
+*/
+struct PQexternalBuffer_ {
+    
+    unsigned char *pData;
+    size_t capacity;                        /* Length of pData */
+    unsigned long long start;               /* Offset in the file of pData[0] */
+    size_t length;                          /* Number of bytes of the file in pData */
+    
+};
+
+
+struct PQexternalRun_ {
+    
+    FILE *file;
+    unsigned long long size;                /* Length of the file */
+    unsigned long long front;               /* Offset of the first record not pulled yet */
+    unsigned long long back;                /* End of the last record not pulled yet */
+    unsigned long long count;               /* Number of records not pulled yet */
+    unsigned int level;                     /* Number of merges the records went through */
+    
+    struct PQexternalBuffer_ head;          /* Block read at the front */
+    struct PQexternalBuffer_ tail;          /* Block read at the back */
+    void *headPriority, *headElem;          /* The first record, loaded */
+    void *tailPriority, *tailElem;          /* The last record, loaded (the same one when count is 1) */
+    size_t headSize, tailSize;              /* Size of these records in the file */
+    
+};
+
+
+
+
+
+
+/*  Read size bytes of a run at offset. The file was flushed after it was written,
+    from then on it is only read.
+*/
+static int pq_external_read(struct PQexternalRun_ *run, unsigned long long offset, unsigned char *pData, size_t size) {
+    
+#ifdef PQ_EXTERNAL_POSIX
+    size_t done;
+    ssize_t got;
+    
+    for (done = 0; done < size; done += (size_t) got) {
+        got = pread(fileno(run->file), (void *) (pData + done), size - done, (off_t) (offset + done));
+        if (got <= 0)
+            return -3;
+    }
+    
+    return 0;
+#else
+#if defined(_WIN32)
+    if (_fseeki64(run->file, (__int64) offset, SEEK_SET) != 0)
+        return -3;
+#else
+    if (offset > (unsigned long long) LONG_MAX || fseek(run->file, (long) offset, SEEK_SET) != 0)
+        return -3;
+#endif
+    return fread((void *) pData, 1, size, run->file) == size ? 0 : -3;
+#endif
+}
+
+
+
+
+
+/*  Make the bytes [offset, offset + size) of a run available in the buffer. A miss
+    reads the block which starts at offset (forward) or ends there (backward).
+*/
+static const unsigned char *pq_external_fetch(
+    PQexternal *eq,
+    struct PQexternalRun_ *run,
+    struct PQexternalBuffer_ *buffer,
+    unsigned long long offset,
+    size_t size,
+    int isBackward
+)
+{
+    
+    unsigned char *pData;
+    unsigned long long start, end;
+    size_t capacity;
+    
+    
+    if (offset + size > run->size)
+        return 0;
+    if (offset >= buffer->start && offset + size <= buffer->start + buffer->length)
+        return buffer->pData + (offset - buffer->start);
+    
+    if (pq_external_align(size) > buffer->capacity) {
+        capacity = pq_external_align(size);
+        pData = (unsigned char *) pq_mem_realloc(&eq->queue, (void *) buffer->pData,
+                                                  buffer->capacity, capacity);
+        if (pData == 0)
+            return 0;
+        buffer->pData = pData;
+        buffer->capacity = capacity;
+    }
+    
+    if (isBackward == 0) {
+        start = offset;
+        end = run->size - start < buffer->capacity ? run->size : start + buffer->capacity;
+    }
+    else {
+        end = offset + size;
+        start = end < buffer->capacity ? 0 : end - buffer->capacity;
+    }
+    
+    buffer->length = 0;
+    if (pq_external_read(run, start, buffer->pData, (size_t) (end - start)) != 0)
+        return 0;
+    buffer->start = start;
+    buffer->length = (size_t) (end - start);
+    
+    return buffer->pData + (offset - start);
+}
+
+
+
+
+
+/*  Load the record which starts at offset (forward) or ends there (backward).
+    Only the priority is loaded when elem is NULL.
+*/
+static int pq_external_load(
+    PQexternal *eq,
+    struct PQexternalRun_ *run,
+    struct PQexternalBuffer_ *buffer,
+    unsigned long long offset,
+    int isBackward,
+    void **priority,
+    void **elem,
+    size_t *recordSize
+)
+{
+    
+    const unsigned char *pRecord;
+    unsigned int sizes[2];
+    size_t size;
+    
+    
+    if (isBackward != 0 && offset < PQ_EXTERNAL_SIZES)
+        return -3;
+    pRecord = pq_external_fetch(eq, run, buffer, isBackward == 0 ? offset : offset - PQ_EXTERNAL_SIZES,
+                                PQ_EXTERNAL_SIZES, isBackward);
+    if (pRecord == 0)
+        return -3;
+    memcpy(sizes, pRecord, PQ_EXTERNAL_SIZES);
+    
+    size = pq_external_record_size(sizes);
+    if (isBackward != 0) {
+        if (offset < size)
+            return -3;
+        offset -= size;
+    }
+    pRecord = pq_external_fetch(eq, run, buffer, offset, size, isBackward);
+    if (pRecord == 0)
+        return -3;
+    
+    
+    *priority = eq->serializer.fpLoadPriority(eq->serializer.context,
+                                              (const void *) (pRecord + PQ_EXTERNAL_SIZES), sizes[0]);
+    if (*priority == 0)
+        return -3;
+    if (elem != 0) {
+        *elem = eq->serializer.fpLoadElement(eq->serializer.context, (const void *) (pRecord +
+                                             PQ_EXTERNAL_SIZES + pq_external_align(sizes[0])), sizes[1]);
+        if (*elem == 0) {
+            eq->queue.fpDestroyPriority(*priority);
+            return -3;
+        }
+    }
+    *recordSize = size;
+    
+    return 0;
+}
+
+
+
+
+
+/*  Convert an object into the record buffer at offset, which grows (at least
+    doubling) until the bytes, their padding and the closing sizes fit.
+*/
+static int pq_external_serialize(
+    PQexternal *eq,
+    size_t offset,
+    size_t (*fpSave) (void *context, const void *object, void *buffer, size_t size),
+    const void *object,
+    unsigned int *pSize
+)
+{
+    
+    unsigned char *pRecord;
+    size_t size, needed, newSize;
+    int isWritten;
+    
+    
+    size = fpSave(eq->serializer.context, object, (void *) (eq->pRecord + offset), eq->recordSize - offset);
+    if (size == (size_t) -1 || size > UINT_MAX)
+        return -3;
+    isWritten = size <= eq->recordSize - offset ? 1 : 0;
+    
+    needed = offset + pq_external_align(size) + 2 * PQ_EXTERNAL_SIZES;
+    if (needed > eq->recordSize) {
+        newSize = needed > 2 * eq->recordSize ? needed : 2 * eq->recordSize;
+        pRecord = (unsigned char *) pq_mem_realloc(&eq->queue, (void *) eq->pRecord, eq->recordSize, newSize);
+        if (pRecord == 0)
+            return -2;
+        eq->pRecord = pRecord;
+        eq->recordSize = newSize;
+    }
+    if (isWritten == 0 &&
+        fpSave(eq->serializer.context, object, (void *) (eq->pRecord + offset), eq->recordSize - offset) != size)
+        return -3;
+    
+    memset((void *) (eq->pRecord + offset + size), 0, pq_external_align(size) - size);
+    *pSize = (unsigned int) size;
+    
+    return 0;
+}
+
+
+
+
+
+static int pq_external_write(PQexternal *eq, FILE *file, const PQnode *pNode, unsigned long long *pOffset) {
+    
+    unsigned int sizes[2];
+    size_t elementOffset, size;
+    int result;
+    
+    
+    result = pq_external_serialize(eq, PQ_EXTERNAL_SIZES, eq->serializer.fpSavePriority,
+                                   pNode->priority, sizes + 0);
+    if (result != 0)
+        return result;
+    elementOffset = PQ_EXTERNAL_SIZES + pq_external_align(sizes[0]);
+    result = pq_external_serialize(eq, elementOffset, eq->serializer.fpSaveElement, pNode->elem, sizes + 1);
+    if (result != 0)
+        return result;
+    
+    size = pq_external_record_size(sizes);
+    memcpy((void *) eq->pRecord, sizes, PQ_EXTERNAL_SIZES);
+    memcpy((void *) (eq->pRecord + size - PQ_EXTERNAL_SIZES), sizes, PQ_EXTERNAL_SIZES);
+    if (fwrite((const void *) eq->pRecord, 1, size, file) != size)
+        return -3;
+    *pOffset += size;
+    
+    return 0;
+}
+
+
+
+
+
+/*  A new run file, which is removed at once and lives until it is closed. Without
+    mkstemp() every run goes to tmpfile(), which removes it on close as well.
+*/
+static FILE *pq_external_create(PQexternal *eq) {
+    
+#ifdef PQ_EXTERNAL_POSIX
+    FILE *file;
+    char *path;
+    size_t pathSize;
+    int fd;
+    
+    
+    if (eq->pDirectory == 0)
+        return tmpfile();
+    
+    pathSize = strlen(eq->pDirectory) + sizeof(PQ_EXTERNAL_RUN_NAME);
+    path = (char *) pq_mem_alloc(&eq->queue, pathSize);
+    if (path == 0)
+        return 0;
+    strcpy(path, eq->pDirectory);
+    strcat(path, PQ_EXTERNAL_RUN_NAME);
+    
+    file = 0;
+    fd = mkstemp(path);
+    if (fd >= 0) {
+        unlink(path);
+        file = fdopen(fd, "w+b");
+        if (file == 0)
+            close(fd);
+    }
+    pq_mem_free(&eq->queue, (void *) path, pathSize);
+    
+    return file;
+#else
+    (void) eq;
+    return tmpfile();
+#endif
+}
+
+
+
+
+
+/*  Close a run, destroying its loaded records which were not pulled */
+static void pq_external_close(PQexternal *eq, struct PQexternalRun_ *run) {
+    
+    if (run->count >= 1) {
+        eq->queue.fpDestroyPriority(run->headPriority);
+        eq->queue.fpDestroyElement(run->headElem);
+    }
+    if (run->count >= 2) {
+        eq->queue.fpDestroyPriority(run->tailPriority);
+        eq->queue.fpDestroyElement(run->tailElem);
+    }
+    if (run->head.pData != 0)
+        pq_mem_free(&eq->queue, (void *) run->head.pData, run->head.capacity);
+    if (run->tail.pData != 0)
+        pq_mem_free(&eq->queue, (void *) run->tail.pData, run->tail.capacity);
+    fclose(run->file);
+    
+    return;
+}
+
+
+
+
+
+/*  Make a run of a file which holds count records, and load its first and last record */
+static int pq_external_open(
+    PQexternal *eq,
+    struct PQexternalRun_ *run,
+    FILE *file,
+    unsigned long long size,
+    unsigned long long count,
+    unsigned int level
+)
+{
+    
+    memset((void *) run, 0, sizeof(struct PQexternalRun_));
+    run->file = file;
+    run->size = size;
+    run->back = size;
+    run->level = level;
+    
+    run->head.capacity = eq->blockSize;
+    run->tail.capacity = eq->blockSize;
+    run->head.pData = (unsigned char *) pq_mem_alloc(&eq->queue, eq->blockSize);
+    run->tail.pData = (unsigned char *) pq_mem_alloc(&eq->queue, eq->blockSize);
+    if (run->head.pData == 0 || run->tail.pData == 0) {
+        pq_external_close(eq, run);
+        return -2;
+    }
+    
+    if (pq_external_load(eq, run, &run->head, 0, 0, &run->headPriority, &run->headElem, &run->headSize) != 0) {
+        pq_external_close(eq, run);
+        return -3;
+    }
+    run->count = 1;
+    if (count == 1) {
+        run->tailPriority = run->headPriority;
+        run->tailElem = run->headElem;
+        run->tailSize = run->headSize;
+        return 0;
+    }
+    if (pq_external_load(eq, run, &run->tail, size, 1, &run->tailPriority, &run->tailElem, &run->tailSize) != 0) {
+        pq_external_close(eq, run);
+        return -3;
+    }
+    run->count = count;
+    
+    return 0;
+}
+
+
+
+
+
+static int pq_external_reserve_run(PQexternal *eq) {
+    
+    struct PQexternalRun_ *pRuns;
+    unsigned int newCapacity;
+    
+    if (eq->runCount < eq->runCapacity)
+        return 0;
+    
+    newCapacity = eq->runCapacity == 0 ? PQ_EXTERNAL_MERGE_FANOUT : 2 * eq->runCapacity;
+    pRuns = (struct PQexternalRun_ *) pq_mem_realloc(&eq->queue, (void *) eq->pRuns,
+                    eq->runCapacity * sizeof(struct PQexternalRun_),
+                    newCapacity * sizeof(struct PQexternalRun_));
+    if (pRuns == 0)
+        return -2;
+    eq->pRuns = pRuns;
+    eq->runCapacity = newCapacity;
+    
+    return 0;
+}
+
+
+
+
+
+static void pq_external_remove_run(PQexternal *eq, unsigned int index) {
+    
+    eq->runCount -= 1;
+    if (index != eq->runCount)
+        eq->pRuns[index] = eq->pRuns[eq->runCount];
+    
+    return;
+}
+
+
+
+
+
+/*  Merge PQ_EXTERNAL_MERGE_FANOUT runs of the given level into one run of the next
+    level. The records are copied as they are, only their priorities are loaded
+    to compare them. A failed merge leaves the runs as they were.
+*/
+static int pq_external_merge(PQexternal *eq, unsigned int level) {
+    
+    struct PQexternalRun_ *run, merged;
+    unsigned int inputs[PQ_EXTERNAL_MERGE_FANOUT];
+    unsigned long long cursor[PQ_EXTERNAL_MERGE_FANOUT];
+    void *current[PQ_EXTERNAL_MERGE_FANOUT];
+    size_t recordSize[PQ_EXTERNAL_MERGE_FANOUT];
+    const unsigned char *pRecord;
+    unsigned long long offset, count;
+    unsigned int index, input, best;
+    FILE *file;
+    int result;
+    
+    
+    input = 0;
+    count = 0;
+    for (index = 0; index < eq->runCount && input < PQ_EXTERNAL_MERGE_FANOUT; index += 1) {
+        if (eq->pRuns[index].level == level) {
+            inputs[input] = index;
+            current[input] = 0;
+            input += 1;
+            count += eq->pRuns[index].count;
+        }
+    }
+    
+    file = pq_external_create(eq);
+    if (file == 0)
+        return -3;
+    setvbuf(file, 0, _IOFBF, eq->blockSize);
+    
+    result = 0;
+    for (input = 0; result == 0 && input < PQ_EXTERNAL_MERGE_FANOUT; input += 1) {
+        run = eq->pRuns + inputs[input];
+        cursor[input] = run->front;
+        result = pq_external_load(eq, run, &run->head, cursor[input], 0, current + input, 0, recordSize + input);
+    }
+    
+    
+    /* Every step copies the lowest of the current records of the inputs */
+    offset = 0;
+    while (result == 0) {
+        best = PQ_EXTERNAL_MERGE_FANOUT;
+        for (input = 0; input < PQ_EXTERNAL_MERGE_FANOUT; input += 1) {
+            if (current[input] != 0 && (best == PQ_EXTERNAL_MERGE_FANOUT ||
+                    pq_compare_priority(&eq->queue, current[input], current[best]) < 0))
+                best = input;
+        }
+        if (best == PQ_EXTERNAL_MERGE_FANOUT)
+            break;
+    
+        run = eq->pRuns + inputs[best];
+        pRecord = pq_external_fetch(eq, run, &run->head, cursor[best], recordSize[best], 0);
+        if (pRecord == 0 || fwrite((const void *) pRecord, 1, recordSize[best], file) != recordSize[best]) {
+            result = -3;
+            break;
+        }
+        offset += recordSize[best];
+        cursor[best] += recordSize[best];
+        eq->queue.fpDestroyPriority(current[best]);
+        current[best] = 0;
+        if (cursor[best] < run->back)
+            result = pq_external_load(eq, run, &run->head, cursor[best], 0, current + best, 0, recordSize + best);
+    }
+    
+    for (input = 0; input < PQ_EXTERNAL_MERGE_FANOUT; input += 1) {
+        if (current[input] != 0)
+            eq->queue.fpDestroyPriority(current[input]);
+    }
+    if (result == 0 && fflush(file) != 0)
+        result = -3;
+    if (result != 0) {
+        fclose(file);
+        return result;
+    }
+    result = pq_external_open(eq, &merged, file, offset, count, level + 1);
+    if (result != 0)
+        return result;
+    
+    
+    /* The inputs go from the highest index down, so the ones left keep their place */
+    input = PQ_EXTERNAL_MERGE_FANOUT;
+    while (input > 0) {
+        input -= 1;
+        pq_external_close(eq, eq->pRuns + inputs[input]);
+        pq_external_remove_run(eq, inputs[input]);
+    }
+    eq->pRuns[eq->runCount] = merged;
+    eq->runCount += 1;
+    eq->mergeCount += 1;
+    
+    return 0;
+}
+
+
+
+
+
+/*  Merge while some level has PQ_EXTERNAL_MERGE_FANOUT runs. A failed merge is
+    tried again after the next spill, the runs stay usable meanwhile.
+*/
+static void pq_external_merge_levels(PQexternal *eq) {
+    
+    unsigned int index, other, count;
+    
+    for (index = 0; index < eq->runCount; index += 1) {
+        count = 0;
+        for (other = 0; other < eq->runCount; other += 1) {
+            if (eq->pRuns[other].level == eq->pRuns[index].level)
+                count += 1;
+        }
+        if (count < PQ_EXTERNAL_MERGE_FANOUT)
+            continue;
+        if (pq_external_merge(eq, eq->pRuns[index].level) != 0)
+            return;
+        index = (unsigned int) -1;          /* The merged run may fill the next level, start over */
+    }
+    
+    return;
+}
+
+
+
+
+
+/*  Write the middle half of the full in-memory queue to a new run. The lowest
+    and the highest quarter stay, so both ends are served from memory a while.
+*/
+static int pq_external_spill(PQexternal *eq) {
+    
+    PriorityQueue *pq;
+    struct PQexternalRun_ run;
+    unsigned long long offset;
+    unsigned int keep, last, index;
+    FILE *file;
+    int result;
+    
+    
+    pq = &eq->queue;
+    if (pq_external_reserve_run(eq) != 0)
+        return -2;
+    file = pq_external_create(eq);
+    if (file == 0)
+        return -3;
+    setvbuf(file, 0, _IOFBF, eq->blockSize);
+    
+    pq_sort_array(pq);
+    keep = pq_size(pq) / 4;
+    last = pq_size(pq) - keep;
+    
+    result = 0;
+    offset = 0;
+    for (index = keep; result == 0 && index < last; index += 1)
+        result = pq_external_write(eq, file, pq_array(pq) + index, &offset);
+    if (result == 0 && fflush(file) != 0)
+        result = -3;
+    if (result != 0)
+        fclose(file);
+    else
+        result = pq_external_open(eq, &run, file, offset, last - keep, 0);
+    
+    
+    /* The written nodes leave memory, the highest quarter moves down to the lowest */
+    if (result == 0) {
+        for (index = keep; index < last; index += 1) {
+            pq->fpDestroyPriority(pq_array(pq)[index].priority);
+            pq->fpDestroyElement(pq_array(pq)[index].elem);
+        }
+        memmove((void *) (pq_array(pq) + keep), (const void *) (pq_array(pq) + last), keep * sizeof(PQnode));
+        pq_size(pq) = 2 * keep;
+        eq->pRuns[eq->runCount] = run;
+        eq->runCount += 1;
+        eq->spillCount += 1;
+    }
+    
+    pq_opposite_forget(pq);
+    pq_batch_settle(pq, 0);
+    
+    if (result == 0)
+        pq_external_merge_levels(eq);
+    
+    return result;
+}
+
+
+
+
+
+/*  Index of the run whose first (last) record is the lowest (highest), or PQ_INDEX_NONE */
+static unsigned int pq_external_best_run(PQexternal *eq, int direction) {
+    
+    unsigned int index, best;
+    void *priority, *bestPriority;
+    
+    best = PQ_INDEX_NONE;
+    bestPriority = 0;
+    for (index = 0; index < eq->runCount; index += 1) {
+        priority = direction == 1 ? eq->pRuns[index].headPriority : eq->pRuns[index].tailPriority;
+        if (best == PQ_INDEX_NONE || direction * pq_compare_priority(&eq->queue, priority, bestPriority) < 0) {
+            best = index;
+            bestPriority = priority;
+        }
+    }
+    
+    return best;
+}
+
+
+
+
+
+/*  Hand out the first (direction 1) or the last record of a run. The record after
+    it is loaded first, so that a failed read changes nothing.
+*/
+static int pq_external_take(PQexternal *eq, unsigned int index, int direction, void **priority, void **elem) {
+    
+    struct PQexternalRun_ *run;
+    void *nextPriority, *nextElem;
+    size_t nextSize;
+    
+    
+    run = eq->pRuns + index;
+    nextPriority = 0;
+    nextElem = 0;
+    nextSize = 0;
+    if (run->count >= 3 && direction == 1 &&
+        pq_external_load(eq, run, &run->head, run->front + run->headSize, 0,
+                         &nextPriority, &nextElem, &nextSize) != 0)
+        return -3;
+    if (run->count >= 3 && direction == -1 &&
+        pq_external_load(eq, run, &run->tail, run->back - run->tailSize, 1,
+                         &nextPriority, &nextElem, &nextSize) != 0)
+        return -3;
+    
+    if (direction == 1) {
+        *priority = run->headPriority;
+        *elem = run->headElem;
+        run->front += run->headSize;
+    }
+    else {
+        *priority = run->tailPriority;
+        *elem = run->tailElem;
+        run->back -= run->tailSize;
+    }
+    run->count -= 1;
+    
+    
+    /* The record left alone is the first and the last one at the same time */
+    if (run->count == 0) {
+        pq_external_close(eq, run);
+        pq_external_remove_run(eq, index);
+    }
+    else if (run->count == 1 && direction == 1) {
+        run->headPriority = run->tailPriority;
+        run->headElem = run->tailElem;
+        run->headSize = run->tailSize;
+    }
+    else if (run->count == 1) {
+        run->tailPriority = run->headPriority;
+        run->tailElem = run->headElem;
+        run->tailSize = run->headSize;
+    }
+    else if (direction == 1) {
+        run->headPriority = nextPriority;
+        run->headElem = nextElem;
+        run->headSize = nextSize;
+    }
+    else {
+        run->tailPriority = nextPriority;
+        run->tailElem = nextElem;
+        run->tailSize = nextSize;
+    }
+    
+    return 0;
+}
+
+
+
+
+
+/*  Serve a pull or a peek of one end (direction 1: minimum, -1: maximum) from
+    the in-memory queue or from the best run, whichever holds the better element.
+*/
+static int pq_external_extreme(PQexternal *eq, int direction, int isPull, void **priority, void **elem) {
+    
+    struct PQexternalRun_ *run;
+    unsigned int best;
+    void *memPriority, *memElem;
+    int result;
+    
+    
+    /* Check for invalid function arguments */
+    if (eq == 0 || priority == 0 || elem == 0 || eq->nodeCount == 0)
+        return -1;
+    
+    best = pq_external_best_run(eq, direction);
+    if (pq_size(&eq->queue) != 0) {
+        if (direction == 1)
+            pq_peek_minimum(&eq->queue, &memPriority, &memElem);
+        else
+            pq_peek_maximum(&eq->queue, &memPriority, &memElem);
+    
+        run = best == PQ_INDEX_NONE ? 0 : eq->pRuns + best;
+        if (run == 0 || direction * pq_compare_priority(&eq->queue, memPriority,
+                            direction == 1 ? run->headPriority : run->tailPriority) <= 0) {
+            *priority = memPriority;
+            *elem = memElem;
+            if (isPull == 0)
+                return 0;
+            if (direction == 1)
+                pq_pull_minimum(&eq->queue, priority, elem);
+            else
+                pq_pull_maximum(&eq->queue, priority, elem);
+            eq->nodeCount -= 1;
+            return 0;
+        }
+    }
+    
+    run = eq->pRuns + best;
+    if (isPull == 0) {
+        *priority = direction == 1 ? run->headPriority : run->tailPriority;
+        *elem = direction == 1 ? run->headElem : run->tailElem;
+        return 0;
+    }
+    
+    result = pq_external_take(eq, best, direction, priority, elem);
+    if (result == 0)
+        eq->nodeCount -= 1;
+    
+    return result;
+}
+
+
+
+
+
+int pq_external_init(
+    PQexternal *eq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int memoryLimit,
+    size_t blockSize,
+    const char *directory,
+    const PQserializer *serializer,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    size_t directorySize;
+    int result;
+    
+    
+    /* Check for invalid function arguments */
+    if (eq == 0 || serializer == 0 || fpComparePriority == 0 || fpDestroyPriority == 0 || fpDestroyElement == 0)
+        return -1;
+    if (serializer->fpSavePriority == 0 || serializer->fpSaveElement == 0 ||
+        serializer->fpLoadPriority == 0 || serializer->fpLoadElement == 0 ||
+        serializer->priorityBytes != 0 || serializer->elementBytes != 0)
+        return -1;
+    if (memoryLimit < 8 || engine == PQ_ENGINE_RADIX_HEAP || engine == PQ_ENGINE_PAIRING_HEAP)
+        return -1;
+    
+    memset((void *) eq, 0, sizeof(PQexternal));
+    result = pq_init_engine(&eq->queue, engine, hOrientation, memoryLimit,
+                            fpComparePriority, fpDestroyPriority, fpDestroyElement);
+    if (result != 0)
+        return result;
+    
+    eq->memoryLimit = memoryLimit;
+    eq->blockSize = pq_external_align(blockSize == 0 ? (size_t) PQ_EXTERNAL_DEFAULT_BLOCK : blockSize);
+    eq->serializer = *serializer;
+    
+    
+    eq->recordSize = PQ_EXTERNAL_RECORD_BUFFER;
+    eq->pRecord = (unsigned char *) pq_mem_alloc(&eq->queue, eq->recordSize);
+    if (directory != 0) {
+        directorySize = strlen(directory) + 1;
+        eq->pDirectory = (char *) pq_mem_alloc(&eq->queue, directorySize);
+        if (eq->pDirectory != 0)
+            memcpy((void *) eq->pDirectory, (const void *) directory, directorySize);
+    }
+    if (eq->pRecord == 0 || (directory != 0 && eq->pDirectory == 0)) {
+        pq_external_destroy(eq);
+        return -2;
+    }
+    
+    return 0;
+}
+
+
+
+
+
+void pq_external_destroy(PQexternal *eq) {
+    
+    unsigned int index;
+    
+    
+    /* Check for invalid function arguments */
+    if (eq == 0)
+        return;
+    
+    for (index = 0; index < eq->runCount; index += 1)
+        pq_external_close(eq, eq->pRuns + index);
+    if (eq->pRuns != 0)
+        pq_mem_free(&eq->queue, (void *) eq->pRuns, eq->runCapacity * sizeof(struct PQexternalRun_));
+    if (eq->pRecord != 0)
+        pq_mem_free(&eq->queue, (void *) eq->pRecord, eq->recordSize);
+    if (eq->pDirectory != 0)
+        pq_mem_free(&eq->queue, (void *) eq->pDirectory, strlen(eq->pDirectory) + 1);
+    
+    pq_destroy(&eq->queue);
+    memset((void *) eq, 0, sizeof(PQexternal));
+    
+    return;
+}
+
+
+
+
+
+int pq_external_insert_with_priority(PQexternal *eq, const void *elem, const void *priority) {
+    
+    int result;
+    
+    
+    /* Check for invalid function arguments */
+    if (eq == 0 || elem == 0 || priority == 0)
+        return -1;
+    
+    if (pq_size(&eq->queue) >= eq->memoryLimit) {
+        result = pq_external_spill(eq);
+        if (result != 0)
+            return result;
+    }
+    
+    result = pq_insert_with_priority(&eq->queue, elem, priority);
+    if (result == 0)
+        eq->nodeCount += 1;
+    
+    return result;
+}
+
+
+
+
+
+int pq_external_pull_minimum(PQexternal *eq, void **priority, void **elem) {
+    
+    return pq_external_extreme(eq, 1, 1, priority, elem);
+}
+
+
+
+
+
+int pq_external_pull_maximum(PQexternal *eq, void **priority, void **elem) {
+    
+    return pq_external_extreme(eq, -1, 1, priority, elem);
+}
+
+
+
+
+
+int pq_external_peek_minimum(PQexternal *eq, void **priority, void **elem) {
+    
+    return pq_external_extreme(eq, 1, 0, priority, elem);
+}
+
+
+
+
+
+int pq_external_peek_maximum(PQexternal *eq, void **priority, void **elem) {
+    
+    return pq_external_extreme(eq, -1, 0, priority, elem);
+}
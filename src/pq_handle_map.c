@@ -0,0 +1,174 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Position map of node handles
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+/*  pNodeHandle[index] is the handle of the node stored at pArrayNode[index].
+    pHandleIndex[handle] is the index of the node identified by handle.
+    Released handles are chained through pHandleIndex, starting at handleFree.
+*/
+
+
+
+
+int pq_handle_map_create(PriorityQueue *pq) {
+    
+    unsigned int *pNodeHandle, *pHandleIndex;
+    unsigned int index;
+    
+    
+    pNodeHandle = (unsigned int *) pq_mem_alloc(pq, pq_capacity(pq) * sizeof(unsigned int));
+    if (pNodeHandle == 0)
+        return -1;
+    pHandleIndex = (unsigned int *) pq_mem_alloc(pq, pq_capacity(pq) * sizeof(unsigned int));
+    if (pHandleIndex == 0) {
+        pq_mem_free(pq, (void *) pNodeHandle, pq_capacity(pq) * sizeof(unsigned int));
+        return -1;
+    }
+    
+    
+    /* Nodes inserted before the map existed carry no handle */
+    for (index = 0; index < pq_size(pq); index += 1)
+        pNodeHandle[index] = PQ_HANDLE_NONE;
+    
+    pq->pNodeHandle = pNodeHandle;
+    pq->nodeHandleCapacity = pq_capacity(pq);
+    pq->pHandleIndex = pHandleIndex;
+    pq->handleCapacity = pq_capacity(pq);
+    pq->handleCount = 0;
+    pq->handleFree = PQ_HANDLE_NONE;
+    
+    return 0;
+}
+
+
+
+
+
+void pq_handle_map_destroy(PriorityQueue *pq) {
+    
+    if (pq->pNodeHandle == 0)
+        return;
+    
+    pq_mem_free(pq, (void *) pq->pHandleIndex, pq->handleCapacity * sizeof(unsigned int));
+    pq_mem_free(pq, (void *) pq->pNodeHandle, pq->nodeHandleCapacity * sizeof(unsigned int));
+    pq->pNodeHandle = 0;
+    pq->nodeHandleCapacity = 0;
+    pq->pHandleIndex = 0;
+    
+    return;
+}
+
+
+
+
+
+int pq_handle_acquire(PriorityQueue *pq, unsigned int index, PQhandle *handle) {
+    
+    unsigned int *pHandleIndex;
+    unsigned int newHandle, newCapacity;
+    
+    
+    if (pq->pNodeHandle == 0)
+        return 0;
+    
+    if (handle == 0) {
+        pq->pNodeHandle[index] = PQ_HANDLE_NONE;
+        return 0;
+    }
+    
+    
+    /* Reuse a released handle, otherwise issue a new one */
+    /* The handle table grows by the growth percent when it is full */
+    if (pq->handleFree != PQ_HANDLE_NONE) {
+        newHandle = pq->handleFree;
+        pq->handleFree = pq->pHandleIndex[newHandle];
+    }
+    else {
+        if (pq->handleCount == pq->handleCapacity) {
+            newCapacity = pq_next_capacity(pq, pq->handleCapacity, (size_t) pq->handleCount + 1);
+            if (newCapacity == 0)
+                return -1;
+            pHandleIndex = (unsigned int *) pq_mem_realloc(pq, (void *) pq->pHandleIndex,
+                        pq->handleCapacity * sizeof(unsigned int),
+                        newCapacity * sizeof(unsigned int));
+            if (pHandleIndex == 0)
+                return -1;
+            pq->pHandleIndex = pHandleIndex;
+            pq->handleCapacity = newCapacity;
+        }
+        newHandle = pq->handleCount;
+        pq->handleCount += 1;
+    }
+    
+    pq->pNodeHandle[index] = newHandle;
+    pq->pHandleIndex[newHandle] = index;
+    *handle = newHandle;
+    
+    return 0;
+}
+
+
+
+
+
+void pq_handle_release(PriorityQueue *pq, unsigned int index) {
+    
+    PQhandle handle;
+    
+    
+    if (pq->pNodeHandle == 0)
+        return;
+    
+    handle = pq->pNodeHandle[index];
+    if (handle == PQ_HANDLE_NONE)
+        return;
+    
+    pq->pHandleIndex[handle] = pq->handleFree;
+    pq->handleFree = handle;
+    pq->pNodeHandle[index] = PQ_HANDLE_NONE;
+    
+    return;
+}
+
+
+
+
+
+int pq_handle_lookup(const PriorityQueue *pq, PQhandle handle, unsigned int *index) {
+    
+    unsigned int position;
+    
+    
+    if (pq->pNodeHandle == 0 || handle >= pq->handleCount)
+        return -1;
+    
+    
+    /* A released handle holds a link of the free chain instead of an index, */
+    /* no node refers back to it, so the round trip check rejects it */
+    position = pq->pHandleIndex[handle];
+    if (position >= pq_size(pq) || pq->pNodeHandle[position] != handle)
+        return -1;
+    
+    *index = position;
+    return 0;
+}
+
@@ -0,0 +1,260 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Binary & d-ary Heap storage engines (PQ_ENGINE_BINARY_HEAP, PQ_ENGINE_DARYx_HEAP)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+
+
+
+
+
+
+
+
+/*  Both swim and sink are written once, parameterized by direction.
+    direction is 1 for a min heap and -1 for a max heap, so that a negative
+    comparison result always means the first node belongs closer to the root.
+    
+    The sifted node is copied out of the array once, the nodes it passes are
+    moved into the hole it left, and it is stored once at its final place.
+*/
+static unsigned int pq_bheap_swim(PriorityQueue *pq, unsigned int index, int direction) {
+    
+    unsigned int parent, shift;
+    PQnode node, *pArray;
+    PQhandle handle;
+    
+    
+    pArray = pq_array(pq);
+    shift = pq->heapArityShift;
+    node = pArray[index];
+    handle = pq_node_handle(pq, index);
+    
+    while (index > 0) {
+        parent = pq_parent_index(index, shift);
+        if (direction * pq_compare_priority(pq, node.priority, pArray[parent].priority) >= 0)
+            break;
+        pq_move_node(pq, index, parent);
+        index = parent;
+    }
+    
+    pq_store_node(pq, index, &node, handle);
+    return index;
+}
+
+
+
+
+
+static unsigned int pq_bheap_sink(PriorityQueue *pq, unsigned int index, int direction) {
+    
+    unsigned int size, shift;
+    unsigned int child, last, best;
+    PQnode node, *pArray;
+    PQhandle handle;
+    
+    
+    pArray = pq_array(pq);
+    size = pq_size(pq);
+    shift = pq->heapArityShift;
+    node = pArray[index];
+    handle = pq_node_handle(pq, index);
+    
+    while (1) {
+        
+        /* All the children of a node are stored next to each other */
+        child = pq_firstchild_index(index, shift);
+        if (child >= size)
+            break;
+        last = child + (1u << shift);
+        if (last > size)
+            last = size;
+        
+        best = child;
+        for (child += 1; child < last; child += 1) {
+            if (direction * pq_compare_priority(pq, pArray[child].priority, pArray[best].priority) < 0)
+                best = child;
+        }
+        if (direction * pq_compare_priority(pq, pArray[best].priority, node.priority) >= 0)
+            break;
+        
+        pq_move_node(pq, index, best);
+        index = best;
+    }
+    
+    pq_store_node(pq, index, &node, handle);
+    return index;
+}
+
+
+
+
+
+unsigned int pq_bheap_swim_light(PriorityQueue *pq, unsigned int index) {
+    
+    return pq_bheap_swim(pq, index, 1);
+}
+
+
+
+
+
+unsigned int pq_bheap_sink_heavy(PriorityQueue *pq, unsigned int index) {
+    
+    return pq_bheap_sink(pq, index, 1);
+}
+
+
+
+
+
+unsigned int pq_bheap_swim_heavy(PriorityQueue *pq, unsigned int index) {
+    
+    return pq_bheap_swim(pq, index, -1);
+}
+
+
+
+
+
+unsigned int pq_bheap_sink_light(PriorityQueue *pq, unsigned int index) {
+    
+    return pq_bheap_sink(pq, index, -1);
+}
+
+
+
+
+
+void pq_bheap_build_minheap(PriorityQueue *pq) {
+    
+    unsigned int index;
+    
+    
+    /* Sink every internal node, starting from the last one */
+    index = pq_size(pq) < 2 ? 0 : pq_parent_index(pq_size(pq) - 1, pq->heapArityShift) + 1;
+    while (index > 0) {
+        index -= 1;
+        pq_bheap_sink(pq, index, 1);
+    }
+    
+    return;
+}
+
+
+
+
+
+void pq_bheap_build_maxheap(PriorityQueue *pq) {
+    
+    unsigned int index;
+    
+    
+    /* Sink every internal node, starting from the last one */
+    index = pq_size(pq) < 2 ? 0 : pq_parent_index(pq_size(pq) - 1, pq->heapArityShift) + 1;
+    while (index > 0) {
+        index -= 1;
+        pq_bheap_sink(pq, index, -1);
+    }
+    
+    return;
+}
+
+
+
+
+
+void pq_bheap_orient(PriorityQueue *pq, enum PQ_HeapOrient_t hOrientation) {
+    
+    if (hOrientation == PQ_HEAP_MIN)
+        pq_bheap_build_minheap(pq);
+    else
+        pq_bheap_build_maxheap(pq);
+    
+    pq_heap_orientation(pq) = hOrientation;
+    pq_opposite_forget(pq);
+    pq->oppositePulls = 0;
+    pq->rebuildCount += 1;
+    
+    return;
+}
+
+
+
+
+
+unsigned int pq_bheap_opposite_index(PriorityQueue *pq) {
+    
+    unsigned int index, best;
+    int direction;
+    PQnode *pArray;
+    
+    
+    if (pq->oppositeIndex != PQ_INDEX_NONE)
+        return pq->oppositeIndex;
+    
+    
+    /* Every node beyond the parent of the last node is a leaf */
+    /* direction is -1 when looking for the maximum of a min heap, 1 otherwise */
+    pArray = pq_array(pq);
+    direction = pq_heap_orientation(pq) == PQ_HEAP_MIN ? -1 : 1;
+    best = pq_size(pq) < 2 ? 0 : pq_parent_index(pq_size(pq) - 1, pq->heapArityShift) + 1;
+    for (index = best + 1; index < pq_size(pq); index += 1) {
+        if (direction * pq_compare_node(pq, pArray + index, pArray + best) < 0)
+            best = index;
+    }
+    
+    pq->oppositeIndex = best;
+    pq->leafScanCount += 1;
+    
+    return best;
+}
+
+
+
+
+
+void pq_bheap_opposite_track(PriorityQueue *pq, unsigned int index) {
+    
+    unsigned int position, parent, last;
+    int direction;
+    
+    
+    /* A single node is both extremes */
+    last = pq_size(pq) - 1;
+    if (last == 0) {
+        pq->oppositeIndex = 0;
+        return;
+    }
+    if (pq->oppositeIndex == PQ_INDEX_NONE)
+        return;
+    
+    
+    /* Follow the opposite extreme if it was one of the nodes which moved down */
+    for (position = last; position != index; position = parent) {
+        parent = pq_parent_index(position, pq->heapArityShift);
+        if (parent == pq->oppositeIndex) {
+            pq->oppositeIndex = position;
+            break;
+        }
+    }
+    
+    direction = pq_heap_orientation(pq) == PQ_HEAP_MIN ? -1 : 1;
+    if (direction * pq_compare_node(pq, pq_array(pq) + index, pq_array(pq) + pq->oppositeIndex) < 0)
+        pq->oppositeIndex = index;
+    
+    return;
+}
+
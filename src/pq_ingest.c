@@ -0,0 +1,223 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Lock-free multi producer ingestion ring buffer
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_concurrent.h"
+#include "pq_internal.h"
+#include <stdlib.h>
+
+
+
+
+/*  Every cell carries a sequence number which tells its state for the lap
+    (position) the producers and the consumer are at:
+        sequence == position        :   free, a producer may claim it
+        sequence == position + 1    :   published, the consumer may drain it
+    Draining sets it to position + capacity, the position of the next lap.
+*/
+struct PQingestCell_ {
+    
+    unsigned int sequence;
+    const void *elem;
+    const void *priority;
+};
+
+
+
+
+
+
+int pq_ingest_init(PQingest *ring, PriorityQueue *pq, unsigned int capacity) {
+    
+    unsigned int size, index;
+    
+    
+    /* Check for invalid function arguments */
+    if (ring == 0 || pq == 0 || capacity == 0 || capacity > (~0u >> 1) + 1)
+        return -1;
+    
+    size = 1;
+    while (size < capacity)
+        size = size << 1;
+    
+    
+    /* The memory of the ring comes from the allocator of the queue */
+    ring->pCells = (struct PQingestCell_ *) pq_mem_alloc(pq, size * sizeof(struct PQingestCell_));
+    ring->pBatchElem = (const void **) pq_mem_alloc(pq, size * sizeof(void *));
+    ring->pBatchPriority = (const void **) pq_mem_alloc(pq, size * sizeof(void *));
+    if (ring->pCells == 0 || ring->pBatchElem == 0 || ring->pBatchPriority == 0) {
+        pq_mem_free(pq, (void *) ring->pBatchPriority, size * sizeof(void *));
+        pq_mem_free(pq, (void *) ring->pBatchElem, size * sizeof(void *));
+        pq_mem_free(pq, (void *) ring->pCells, size * sizeof(struct PQingestCell_));
+        return -2;
+    }
+    
+    for (index = 0; index < size; index += 1)
+        ring->pCells[index].sequence = index;
+    
+    ring->pq = pq;
+    ring->capacity = size;
+    ring->batchCount = 0;
+    ring->dequeuePos = 0;
+    __atomic_store_n(&ring->enqueuePos, 0, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+
+
+
+
+int pq_ingest_destroy(PQingest *ring) {
+    
+    PriorityQueue *pq;
+    int result;
+    
+    
+    /* Check for invalid function arguments */
+    if (ring == 0)
+        return -1;
+    
+    result = pq_ingest_drain(ring);
+    
+    pq = ring->pq;
+    pq_mem_free(pq, (void *) ring->pBatchPriority, ring->capacity * sizeof(void *));
+    pq_mem_free(pq, (void *) ring->pBatchElem, ring->capacity * sizeof(void *));
+    pq_mem_free(pq, (void *) ring->pCells, ring->capacity * sizeof(struct PQingestCell_));
+    
+    return result < 0 ? result : 0;
+}
+
+
+
+
+
+int pq_ingest_insert(PQingest *ring, const void *elem, const void *priority) {
+    
+    struct PQingestCell_ *pCell;
+    unsigned int position, sequence;
+    int distance;
+    
+    
+    /* Check for invalid function arguments */
+    if (ring == 0 || elem == 0 || priority == 0)
+        return -1;
+    
+    
+    /*  Claim the cell at the enqueue position if it is free for this lap.
+        A cell of the previous lap which is not drained yet means the ring is full,
+        a cell of this lap which is already claimed means another producer won,
+        then try again at the new position.
+    */
+    position = __atomic_load_n(&ring->enqueuePos, __ATOMIC_RELAXED);
+    while (1) {
+        pCell = ring->pCells + (position & (ring->capacity - 1));
+        sequence = __atomic_load_n(&pCell->sequence, __ATOMIC_ACQUIRE);
+        distance = (int) (sequence - position);
+        if (distance == 0) {
+            if (__atomic_compare_exchange_n(&ring->enqueuePos, &position, position + 1, 1,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED) != 0)
+                break;
+        }
+        else if (distance < 0) {
+            return -3;
+        }
+        else {
+            position = __atomic_load_n(&ring->enqueuePos, __ATOMIC_RELAXED);
+        }
+    }
+    
+    
+    /* Publish the element */
+    pCell->elem = elem;
+    pCell->priority = priority;
+    __atomic_store_n(&pCell->sequence, position + 1, __ATOMIC_RELEASE);
+    
+    return 0;
+}
+
+
+
+
+
+int pq_ingest_drain(PQingest *ring) {
+    
+    struct PQingestCell_ *pCell;
+    unsigned int count;
+    
+    
+    /* Check for invalid function arguments */
+    if (ring == 0)
+        return -1;
+    
+    
+    /* Take every published cell in order, and free it for the next lap */
+    while (ring->batchCount < ring->capacity) {
+        pCell = ring->pCells + (ring->dequeuePos & (ring->capacity - 1));
+        if (__atomic_load_n(&pCell->sequence, __ATOMIC_ACQUIRE) != ring->dequeuePos + 1)
+            break;
+        ring->pBatchElem[ring->batchCount] = pCell->elem;
+        ring->pBatchPriority[ring->batchCount] = pCell->priority;
+        ring->batchCount += 1;
+        __atomic_store_n(&pCell->sequence, ring->dequeuePos + ring->capacity, __ATOMIC_RELEASE);
+        ring->dequeuePos += 1;
+    }
+    
+    if (ring->batchCount == 0)
+        return 0;
+    
+    
+    /* The drained elements stay in the batch until the queue accepts them */
+    if (pq_insert_batch(ring->pq, ring->pBatchElem, ring->pBatchPriority, ring->batchCount) != 0)
+        return -2;
+    
+    count = ring->batchCount;
+    ring->batchCount = 0;
+    
+    return (int) count;
+}
+
+
+
+
+
+int pq_ingest_pull_minimum(PQingest *ring, void **priority, void **elem) {
+    
+    /* Check for invalid function arguments */
+    if (ring == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    if (pq_ingest_drain(ring) == -2)
+        return -2;
+    
+    return pq_pull_minimum(ring->pq, priority, elem);
+}
+
+
+
+
+
+int pq_ingest_pull_maximum(PQingest *ring, void **priority, void **elem) {
+    
+    /* Check for invalid function arguments */
+    if (ring == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    if (pq_ingest_drain(ring) == -2)
+        return -2;
+    
+    return pq_pull_maximum(ring->pq, priority, elem);
+}
+
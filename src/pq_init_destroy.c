@@ -1,108 +1,294 @@
-
-
-/************************************************************************************
-    Implementation of Double Ended Priority Queue ADT
-    Initialization & Destruction functions
-    Author:             Ashis Kumar Das
-    Email:              akd.bracu@gmail.com
-    GitHub:             https://github.com/AKD92
-*************************************************************************************/
-
-
-
-
-
-
-#include "pq.h"
-#include <stdlib.h>
-#include <string.h>
-
-
-
-
-
-
-
-
-
-int pq_init(
-    PriorityQueue *pq,
-    enum PQ_HeapOrient_t hOrientation,
-    unsigned int capacity,
-    int (*fpComparePriority) (const void *pr1, const void *pr2),
-    void (*fpDestroyPriority) (void *priority),
-    void (*fpDestroyElement) (void *element)
-)
-{
-    
-    PQnode *pArray;
-    
-    
-    /* Check for invalid function arguments */
-    if (pq == 0 || fpComparePriority == 0 || capacity == 0)
-        return -1;
-    
-    
-    /* Request to allocate memory storage using malloc() */
-    /* If the request is not granted, return -2 to signal this problem */
-    pArray = 0;
-    pArray = (PQnode *) malloc(capacity * sizeof(PQnode));
-    if (pArray == 0)
-        return -2;
-    
-    
-    /* Adjust all the fields of this Priority Queue */
-    /* With proper values and set all function pointers */
-    memset((void *) pq, 0, sizeof(PriorityQueue));
-    pq->nodeCount = 0;
-    pq->pArrayNode = pArray;
-    pq->heapOrint = hOrientation;
-    pq->arrCapacity = capacity;
-    pq->fpComparePriority = fpComparePriority;
-    pq->fpDestroyPriority = fpDestroyPriority;
-    pq->fpDestroyElement = fpDestroyElement;
-    
-    return 0;
-}
-
-
-
-
-
-void pq_destroy(PriorityQueue *pq) {
-    
-    PQnode *pNode;
-    register unsigned int index;
-    
-    
-    /* Check for invalid function arguments */
-    if (pq == 0)
-        return;
-    
-    if (pq->fpDestroyPriority == 0 && pq->fpDestroyElement == 0)
-        goto DESTROY_END;
-    
-    
-    /* Iterate through each Key and Data object */
-    /* In order to de-allocate them from memory */
-    index = 0;
-    while (index < pq_size(pq)) {
-        pNode = pq_array(pq) + index;
-        if (pq->fpDestroyPriority != 0) {
-            pq->fpDestroyPriority(pNode->priority);
-        }
-        if (pq->fpDestroyElement != 0) {
-            pq->fpDestroyElement(pNode->elem);
-        }
-        index += 1;
-    }
-    
-    
-    /* Release internal memory of this Priority Queue */
-    DESTROY_END:
-    free((void *) pq_array(pq));
-    
-    return;
-}
-
-
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Initialization & Destruction functions
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+
+
+
+
+
+int pq_init(
+    PriorityQueue *pq,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int capacity,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    return pq_init_engine(pq, PQ_ENGINE_BINARY_HEAP, hOrientation, capacity,
+                            fpComparePriority, fpDestroyPriority, fpDestroyElement);
+}
+
+
+
+
+
+int pq_init_engine(
+    PriorityQueue *pq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int capacity,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    return pq_init_allocator(pq, engine, hOrientation, capacity, 0,
+                            fpComparePriority, fpDestroyPriority, fpDestroyElement);
+}
+
+
+
+
+
+int pq_init_allocator(
+    PriorityQueue *pq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    unsigned int capacity,
+    const PQallocator *allocator,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    PQnode *pArray;
+    void *pBlock;
+    unsigned int arityShift;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || fpComparePriority == 0 || capacity == 0 || capacity > PQ_CAPACITY_MAX)
+        return -1;
+    if (allocator != 0 &&
+        (allocator->fpAlloc == 0 || allocator->fpRealloc == 0 || allocator->fpFree == 0))
+        return -1;
+    
+    switch (engine) {
+        case PQ_ENGINE_BINARY_HEAP:
+        case PQ_ENGINE_MINMAX_HEAP:
+            arityShift = 1;
+            break;
+        case PQ_ENGINE_DARY4_HEAP:
+            arityShift = 2;
+            break;
+        case PQ_ENGINE_DARY8_HEAP:
+            arityShift = 3;
+            break;
+        case PQ_ENGINE_PAIRING_HEAP:
+            if (hOrientation != PQ_HEAP_MIN && hOrientation != PQ_HEAP_MAX)
+                return -1;
+            arityShift = 1;
+            break;
+        default:
+            return -1;
+    }
+    
+    
+    /* Adjust all the fields of this Priority Queue */
+    /* With proper values and set all function pointers */
+    memset((void *) pq, 0, sizeof(PriorityQueue));
+    pq->heapEngine = engine;
+    pq->heapArityShift = arityShift;
+    pq->allocator = allocator != 0 ? *allocator : pq_default_allocator;
+    
+    
+    /* Request to allocate memory storage from the allocator */
+    /* If the request is not granted, return -2 to signal this problem */
+    pArray = pq_node_array_alloc(pq, capacity, &pBlock);
+    if (pArray == 0)
+        return -2;
+    
+    /* The pairing heap links its nodes through a parallel array */
+    pq->pairRoot = PQ_INDEX_NONE;
+    if (engine == PQ_ENGINE_PAIRING_HEAP) {
+        pq->pPairLink = (PQpairLink *) pq_mem_alloc(pq, capacity * sizeof(PQpairLink));
+        if (pq->pPairLink == 0) {
+            pq_mem_free(pq, pBlock, pq_node_block_size(pq, capacity));
+            return -2;
+        }
+        pq->pairLinkCapacity = capacity;
+    }
+    
+    pq->nodeCount = 0;
+    pq->pArrayNode = pArray;
+    pq->pArrayBlock = pBlock;
+    pq->heapOrint = hOrientation;
+    pq->oppositeIndex = PQ_INDEX_NONE;
+    pq->oppositePulls = 0;
+    pq->rebuildCount = 0;
+    pq->leafScanCount = 0;
+    memset((void *) &pq->stats, 0, sizeof(PQstats));
+    pq->arrCapacity = capacity;
+    pq->minCapacity = capacity;
+    pq->shrinkBelow = 0;
+    pq->growthPercent = PQ_DEFAULT_GROWTH_PERCENT;
+    pq->shrinkPercent = PQ_DEFAULT_SHRINK_PERCENT;
+    pq->fpComparePriority = fpComparePriority;
+    pq->fpDestroyPriority = fpDestroyPriority;
+    pq->fpDestroyElement = fpDestroyElement;
+    
+    return 0;
+}
+
+
+
+
+
+int pq_init_radix(
+    PriorityQueue *pq,
+    unsigned int capacity,
+    const PQallocator *allocator,
+    unsigned long long (*fpPriorityKey) (const void *priority),
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    unsigned int *pStart;
+    int opInit;
+    
+    
+    /* Check for invalid function arguments */
+    if (fpPriorityKey == 0)
+        return -1;
+    
+    
+    /* The queue starts as a min binary heap, which is also its fallback */
+    opInit = pq_init_allocator(pq, PQ_ENGINE_BINARY_HEAP, PQ_HEAP_MIN, capacity, allocator,
+                            fpComparePriority, fpDestroyPriority, fpDestroyElement);
+    if (opInit != 0)
+        return opInit;
+    
+    pStart = (unsigned int *) pq_mem_alloc(pq, PQ_RADIX_BUCKETS * sizeof(unsigned int));
+    if (pStart == 0) {
+        pq_mem_free(pq, pq->pArrayBlock, pq_node_block_size(pq, pq_capacity(pq)));
+        return -2;
+    }
+    
+    /* All the buckets are empty, every one of them starts at index 0 */
+    memset((void *) pStart, 0, PQ_RADIX_BUCKETS * sizeof(unsigned int));
+    pq->pRadixStart = pStart;
+    pq->radixLast = 0;
+    pq->fpPriorityKey = fpPriorityKey;
+    pq->heapEngine = PQ_ENGINE_RADIX_HEAP;
+    
+    return 0;
+}
+
+
+
+
+
+int pq_init_from_array(
+    PriorityQueue *pq,
+    enum PQ_Engine_t engine,
+    enum PQ_HeapOrient_t hOrientation,
+    const void **elems,
+    const void **priorities,
+    unsigned int count,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    int opInit, opInsert;
+    
+    
+    /* Check for invalid function arguments */
+    if (count != 0 && (elems == 0 || priorities == 0))
+        return -1;
+    
+    
+    /* The queue starts with exactly the capacity it is loaded with */
+    opInit = pq_init_engine(pq, engine, hOrientation, count == 0 ? 1 : count,
+                            fpComparePriority, fpDestroyPriority, fpDestroyElement);
+    if (opInit != 0)
+        return opInit;
+    
+    if (count == 0)
+        return 0;
+    
+    opInsert = pq_insert_batch(pq, elems, priorities, count);
+    if (opInsert != 0) {
+        if (pq->pPairLink != 0)
+            pq_mem_free(pq, pq->pPairLink, pq->pairLinkCapacity * sizeof(PQpairLink));
+        pq_mem_free(pq, pq->pArrayBlock, pq_node_block_size(pq, pq_capacity(pq)));
+        return opInsert;
+    }
+    
+    return 0;
+}
+
+
+
+
+
+void pq_destroy(PriorityQueue *pq) {
+    
+    PQnode *pNode;
+    register unsigned int index;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0)
+        return;
+    
+    if (pq->fpDestroyPriority == 0 && pq->fpDestroyElement == 0)
+        goto DESTROY_END;
+    
+    
+    /* Iterate through each Key and Data object */
+    /* In order to de-allocate them from memory */
+    index = 0;
+    while (index < pq_size(pq)) {
+        pNode = pq_array(pq) + index;
+        if (pq->fpDestroyPriority != 0) {
+            pq->fpDestroyPriority(pNode->priority);
+        }
+        if (pq->fpDestroyElement != 0) {
+            pq->fpDestroyElement(pNode->elem);
+        }
+        index += 1;
+    }
+    
+    
+    /* Release internal memory of this Priority Queue */
+    DESTROY_END:
+    pq_handle_map_destroy(pq);
+    if (pq->pRadixStart != 0)
+        pq_mem_free(pq, pq->pRadixStart, PQ_RADIX_BUCKETS * sizeof(unsigned int));
+    if (pq->pPairLink != 0)
+        pq_mem_free(pq, pq->pPairLink, pq->pairLinkCapacity * sizeof(PQpairLink));
+    pq_mem_free(pq, pq->pArrayBlock, pq_node_block_size(pq, pq_capacity(pq)));
+    pq_snapshot_release(pq);
+    
+    return;
+}
+
+
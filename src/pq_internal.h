@@ -1,73 +1,792 @@
-
-
-/************************************************************************************
-    Internal Program Interface of Double Ended Priority Queue ADT
-    Based on Binary Heap Data Structure (Array Based)
-    Author:             Ashis Kumar Das
-    Email:              akd.bracu@gmail.com
-    GitHub:             https://github.com/AKD92
-*************************************************************************************/
-
-
-
-
-
-
-#ifndef PQ_INTERNAL_H_INCLUDED
-#define PQ_INTERNAL_H_INCLUDED
-
-
-
-
-#include "pq.h"
-
-
-
-#define PQ_DEFAULT_EXPANSION_FACTOR        2
-
-
-
-
-
-/*
- *  Expand the capacity of the underlying array of the specified priority queue.
- *  The capacity needs to be expanded when the underlying array is full and
- *  any new element can not be inserted into the priority queue until and unless
- *  the array is resized (expanded to higher capacity).
- *  It is basically an array-resize function.
- *  
- *  Parameters:
- *      pq          :   The priority queue which is being expanded
- *                      (can not be NULL)
- *
- *  Returns:
- *      (int)           0 if the capacity is expanded (increased) succesfully
- *                      -1 if the memory could not be allocated
- *                      -2 if the specified priority queue is NULL
-*/
-int pq_expand_capacity(PriorityQueue *pq);
-
-
-
-
-
-/*
- *  Compare two elements of type PQnode.
- *  
- *  Parameters:
- *      arg1        :   First argument for a PQnode element
- *      arg2        :   Second argument for another PQnode element
- *
- *  Returns:
- *      (int)           1 if the first PQnode element (arg1) is greater than the second one (arg2)
- *                      0 if the specified PQnode elements are same (equal to each other)
- *                      -1 if the first PQnode element (arg1) is less than the second one (arg2)
-*/
-int pq_compare_node(const void *arg1, const void *arg2);
-
-
-
-
-
-#endif
-
+
+
+/************************************************************************************
+    Internal Program Interface of Double Ended Priority Queue ADT
+    Based on Binary Heap Data Structure (Array Based)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#ifndef PQ_INTERNAL_H_INCLUDED
+#define PQ_INTERNAL_H_INCLUDED
+
+
+
+
+#include "pq.h"
+
+
+
+/* Index arithmetic of the binary & d-ary heaps, the arity is (1 << shift) */
+#define pq_parent_index(index, shift)       (((index) - 1) >> (shift))
+#define pq_firstchild_index(index, shift)   (((index) << (shift)) + 1)
+
+
+
+/* Handle of the node stored at index, PQ_HANDLE_NONE without a position map */
+#define pq_node_handle(pq, index)           ((pq)->pNodeHandle == 0 ? PQ_HANDLE_NONE : \
+                                             (pq)->pNodeHandle[(index)])
+
+
+
+/* Engines which keep one heap, oriented towards one end by heapOrint */
+/* (the pairing heap is oriented too, but handles its opposite extreme itself) */
+#define pq_is_oriented(pq)                  (pq_engine(pq) != PQ_ENGINE_MINMAX_HEAP && \
+                                             pq_engine(pq) != PQ_ENGINE_RADIX_HEAP)
+
+
+
+/* Buckets of the radix heap engine: bucket 0 and one per bit of the keys */
+#define PQ_RADIX_BUCKETS                    65
+
+
+
+/* Links of a node of the pairing heap engine, indices into the PQnode array or PQ_INDEX_NONE */
+struct PQpairLink_ {
+    
+    unsigned int child;                     /* First (leftmost) child */
+    unsigned int sibling;                   /* Next sibling to the right */
+    unsigned int prev;                      /* Previous sibling, or the parent of a first child */
+};
+typedef struct PQpairLink_ PQpairLink;
+
+
+
+/*  The opposite extreme of an oriented heap, oppositeIndex, is known until a pull
+    or any other move of the nodes which is not tracked forgets it.
+    A rebuild costs about as many comparisons as 4 scans of the leaves, so the heap
+    is re-oriented on the 4th pull in a row from the opposite extreme.
+*/
+#define PQ_INDEX_NONE                       (~0u)
+#define PQ_REORIENT_PULLS                   4
+#define pq_opposite_forget(pq)              ((pq)->oppositeIndex = PQ_INDEX_NONE)
+
+
+
+/* Every block of memory owned by a queue comes from its allocator */
+#define pq_mem_alloc(pq, size)              ((pq)->allocator.fpAlloc((pq)->allocator.context, (size)))
+#define pq_mem_realloc(pq, block, oldSize, newSize) \
+                                            ((pq)->allocator.fpRealloc((pq)->allocator.context, \
+                                                (block), (oldSize), (newSize)))
+#define pq_mem_free(pq, block, size)        ((pq)->allocator.fpFree((pq)->allocator.context, \
+                                                (block), (size)))
+
+
+
+/* Counting of the hot paths, compiled in only with PQ_ENABLE_STATS */
+#ifdef PQ_ENABLE_STATS
+#define pq_stats_add(pq, counter, amount)   ((pq)->stats.counter += (amount))
+#else
+#define pq_stats_add(pq, counter, amount)   ((void) 0)
+#endif
+
+
+
+/* Every call of the priority compare function of a queue goes through here */
+#define pq_compare_priority(pq, p1, p2)     (pq_stats_add((pq), comparisons, 1), \
+                                             (pq)->fpComparePriority((const void *) (p1), (const void *) (p2)))
+
+
+
+/* Nonzero if the array of the queue has become too empty, see pq_shrink_capacity() */
+#define pq_should_shrink(pq)                (pq_size(pq) < (pq)->shrinkBelow)
+
+
+
+/* Number of unused slots in front of pArrayNode, see pq_node_array_alloc() */
+#define pq_node_padding(pq)                 (pq_engine(pq) == PQ_ENGINE_DARY4_HEAP || \
+                                             pq_engine(pq) == PQ_ENGINE_DARY8_HEAP ? \
+                                             pq_heap_arity(pq) - 1 : 0)
+
+
+
+
+
+/*
+ *  Expand the capacity of the underlying array of the specified priority queue.
+ *  The capacity needs to be expanded when the underlying array is full and
+ *  any new element can not be inserted into the priority queue until and unless
+ *  the array is resized (expanded to higher capacity).
+ *  It is basically an array-resize function.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which is being expanded
+ *                      (can not be NULL)
+ *
+ *  Returns:
+ *      (int)           0 if the capacity is expanded (increased) succesfully
+ *                      -1 if the memory could not be allocated
+ *                      -2 if the specified priority queue is NULL
+*/
+int pq_expand_capacity(PriorityQueue *pq);
+
+
+
+
+
+
+/*
+ *  Allocate a PQnode array for the specified priority queue.
+ *  For the d-ary heap engines the array starts (padding) slots after a
+ *  cache line boundary, so the children of node i, which start at index
+ *  (i * d + 1), are always at a multiple of d from that boundary.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which will own the array
+ *                      (heapEngine and heapArityShift must be set)
+ *      capacity    :   Number of PQnode elements
+ *      ppBlock     :   Pointer which receives the memory block to be released
+ *
+ *  Returns:
+ *      (PQnode *)      The usable PQnode array, or NULL if the memory could not be allocated
+*/
+PQnode *pq_node_array_alloc(const PriorityQueue *pq, unsigned int capacity, void **ppBlock);
+
+
+
+
+
+/*
+ *  Size in bytes of the memory block which holds a PQnode array of the
+ *  specified capacity, including the padding and alignment of the d-ary engines.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which owns the array
+ *      capacity    :   Number of PQnode elements
+ *
+ *  Returns:
+ *      (size_t)        Size of the memory block in bytes
+*/
+size_t pq_node_block_size(const PriorityQueue *pq, unsigned int capacity);
+
+
+
+
+
+/*
+ *  Allocator which forwards to malloc(), realloc() & free(), used by the
+ *  queues which are not initialized with an allocator of their own.
+*/
+extern const PQallocator pq_default_allocator;
+
+
+
+
+
+/*
+ *  Resize the underlying array of the specified priority queue (and its
+ *  position map, if any) to hold exactly the specified number of nodes,
+ *  but never less than the current number of nodes (and at least 1).
+ *  The memory block is resized in place by the allocator when possible.
+ *  
+ *  Parameters:
+ *      pq              :   The priority queue which is being resized
+ *                          (can not be NULL)
+ *      new_capacity    :   Requested capacity (number of nodes)
+ *
+ *  Returns:
+ *      (int)           0 if the capacity has been changed (or did not need to)
+ *                      -1 if the memory could not be allocated
+ *                      -2 if the specified priority queue is NULL
+*/
+int pq_resize_capacity(PriorityQueue *pq, unsigned int new_capacity);
+
+
+
+
+
+/*
+ *  Compute the capacity an array has to grow to, in order to hold the specified
+ *  number of elements, by repeatedly applying the growth percent of the queue.
+ *  The result saturates at PQ_CAPACITY_MAX.
+ *  
+ *  Parameters:
+ *      pq              :   The priority queue which owns the array
+ *      capacity        :   Current capacity of the array
+ *      needed          :   Number of elements the array has to hold
+ *
+ *  Returns:
+ *      (unsigned int)  New capacity (at least needed), or 0 if needed exceeds PQ_CAPACITY_MAX
+*/
+unsigned int pq_next_capacity(const PriorityQueue *pq, unsigned int capacity, size_t needed);
+
+
+
+
+
+/*
+ *  Shrink the underlying array of the specified priority queue after it has
+ *  become less full than the shrink percent (see pq_should_shrink()), so that
+ *  the growth percent would be needed to fill it again. The capacity never
+ *  drops below the minimum capacity. A failing reallocation keeps the old array.
+ *  
+ *  Parameters:
+ *      pq              :   The priority queue which is being shrunk
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_shrink_capacity(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Leave the specified priority queue empty, as if all of its nodes had been pulled:
+ *  the handles of the nodes are released, the engine forgets them and the array
+ *  shrinks if it should. The priorities and the elements are not destroyed.
+ *  
+ *  Parameters:
+ *      pq              :   The priority queue which is being emptied
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_release_all(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Restore the heap over the nodes appended to the array after the first oldSize
+ *  nodes (pq_size() already counts them), the way the storage engine prefers:
+ *  each new node moves up, or the whole heap is rebuilt bottom-up when that is
+ *  cheaper. A radix heap must not be given keys below its last minimum.
+ *  
+ *  Parameters:
+ *      pq              :   The priority queue whose array has grown
+ *      oldSize         :   Number of nodes the heap held before
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_batch_settle(PriorityQueue *pq, unsigned int oldSize);
+
+
+
+
+
+/*
+ *  Sort the nodes of the array in ascending order of their priorities, in place
+ *  (heapsort). The handles do not follow the nodes and the heap is gone, the
+ *  caller restores it (see pq_batch_settle()).
+ *  
+ *  Parameters:
+ *      pq              :   The priority queue whose array is sorted
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_sort_array(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Unmap the snapshot whose flat priorities or elements the queue holds, if any.
+ *  
+ *  Parameters:
+ *      pq              :   The priority queue being destroyed
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_snapshot_release(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Integer binary logarithm, floor(log2(value)), 0 for value 0 and 1.
+*/
+unsigned int pq_log2(unsigned int value);
+
+
+
+
+
+/*
+ *  Compare two elements of type PQnode, using the compare function
+ *  held by the specified priority queue.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which owns both PQnode elements
+ *      pNode1      :   First argument for a PQnode element
+ *      pNode2      :   Second argument for another PQnode element
+ *
+ *  Returns:
+ *      (int)           1 if the first PQnode element (pNode1) is greater than the second one (pNode2)
+ *                      0 if the specified PQnode elements are same (equal to each other)
+ *                      -1 if the first PQnode element (pNode1) is less than the second one (pNode2)
+*/
+int pq_compare_node(PriorityQueue *pq, const PQnode *pNode1, const PQnode *pNode2);
+
+
+
+
+
+/*
+ *  Store a PQnode element, which was copied out of the array earlier, into the
+ *  specified slot together with its handle. The sift algorithms keep the node
+ *  being sifted out of the array and move the other nodes into the hole it left,
+ *  then store it once at its final place.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which owns the slot
+ *      index       :   Index of the destination slot
+ *      pNode       :   The PQnode element to store
+ *      handle      :   Handle of the PQnode element (PQ_HANDLE_NONE if it has none)
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_store_node(PriorityQueue *pq, unsigned int index, const PQnode *pNode, PQhandle handle);
+
+
+
+
+
+/*
+ *  Move a PQnode element of the underlying array of the specified priority queue
+ *  into another slot, overwriting the node held by the destination slot.
+ *  The handle of the moved node (if any) follows it.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which owns both slots
+ *      dst         :   Index of the destination slot
+ *      src         :   Index of the PQnode element being moved
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_move_node(PriorityQueue *pq, unsigned int dst, unsigned int src);
+
+
+
+
+
+/*
+ *  Restore the heap property of the current storage engine after the priority
+ *  of the node at the given index has been changed (in either direction).
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue being updated
+ *      index       :   Index of the changed node
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_restore_node(PriorityQueue *pq, unsigned int index);
+
+
+
+
+
+/*
+ *  Allocate the position map (pNodeHandle & pHandleIndex) of the specified
+ *  priority queue. Nodes already in the queue receive no handle.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which starts issuing handles
+ *
+ *  Returns:
+ *      (int)           0 if the position map is created
+ *                      -1 if the memory could not be allocated
+*/
+int pq_handle_map_create(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Release the position map of the specified priority queue (if any).
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue being destroyed
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_handle_map_destroy(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Issue a new handle to the node at the given index. If the position map
+ *  exists but no handle is requested, the node is marked with PQ_HANDLE_NONE.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which owns the node
+ *      index       :   Index of the node
+ *      handle      :   Pointer which receives the new handle (can be NULL)
+ *
+ *  Returns:
+ *      (int)           0 if succeeded
+ *                      -1 if the memory could not be allocated
+*/
+int pq_handle_acquire(PriorityQueue *pq, unsigned int index, PQhandle *handle);
+
+
+
+
+
+/*
+ *  Release the handle of the node at the given index, the node is leaving the queue.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which owns the node
+ *      index       :   Index of the node
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_handle_release(PriorityQueue *pq, unsigned int index);
+
+
+
+
+
+/*
+ *  Find the index of the node identified by the given handle.
+ *  
+ *  Parameters:
+ *      pq          :   The priority queue which owns the node
+ *      handle      :   Handle of the node
+ *      index       :   Pointer which receives the index of the node
+ *
+ *  Returns:
+ *      (int)           0 if the handle identifies a node of the queue
+ *                      -1 otherwise
+*/
+int pq_handle_lookup(const PriorityQueue *pq, PQhandle handle, unsigned int *index);
+
+
+
+
+
+/*
+ *  Binary heap (PQ_ENGINE_BINARY_HEAP) and d-ary heap (PQ_ENGINE_DARY4_HEAP,
+ *  PQ_ENGINE_DARY8_HEAP) algorithms, operating directly on the PQnode array
+ *  of the specified priority queue with its arity.
+ *
+ *  Swim Light Element      for min heap, move lower priority elements up on the heap
+ *  Sink Heavy Element      for min heap, move higher priority elements down to the heap
+ *  Swim Heavy Element      for max heap, move higher priority elements up on the heap
+ *  Sink Light Element      for max heap, move lower priority elements down to the heap
+ *
+ *  Parameters:
+ *      pq          :   The priority queue being updated
+ *      index       :   Index of the node which is being moved
+ *
+ *  Returns:
+ *      (unsigned int)  Final index of the node
+*/
+unsigned int pq_bheap_swim_light(PriorityQueue *pq, unsigned int index);
+unsigned int pq_bheap_sink_heavy(PriorityQueue *pq, unsigned int index);
+unsigned int pq_bheap_swim_heavy(PriorityQueue *pq, unsigned int index);
+unsigned int pq_bheap_sink_light(PriorityQueue *pq, unsigned int index);
+
+
+
+
+
+/*
+ *  Rebuild the whole PQnode array of the specified priority queue as
+ *  a min heap or a max heap of its arity (bottom-up, in O(n) time).
+ *
+ *  Parameters:
+ *      pq          :   The priority queue being rebuilt
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_bheap_build_minheap(PriorityQueue *pq);
+void pq_bheap_build_maxheap(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Rebuild the heap of the specified priority queue towards the given
+ *  orientation, and count the rebuild.
+ *
+ *  Parameters:
+ *      pq              :   The priority queue being re-oriented
+ *      hOrientation    :   The new Heap Orientation
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_bheap_orient(PriorityQueue *pq, enum PQ_HeapOrient_t hOrientation);
+
+
+
+
+
+/*
+ *  Locate the extreme opposite to the Heap Orientation (the maximum of a
+ *  min heap, the minimum of a max heap). Unless it is known already, the
+ *  leaves are scanned, which is where such a node always exists.
+ *  The queue must not be empty.
+ *
+ *  Parameters:
+ *      pq          :   The priority queue being searched
+ *
+ *  Returns:
+ *      (unsigned int)  Index of the opposite extreme
+*/
+unsigned int pq_bheap_opposite_index(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Keep the opposite extreme known after the last node of the array has
+ *  been inserted and moved up to the given index, which moved each of
+ *  its former ancestors on the way one level down.
+ *
+ *  Parameters:
+ *      pq          :   The priority queue being updated
+ *      index       :   Final index of the inserted node
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_bheap_opposite_track(PriorityQueue *pq, unsigned int index);
+
+
+
+
+
+/*
+ *  Restore the Min-Max heap property after a new node has been placed
+ *  at the given index (normally the last index of the array).
+ *  The node is moved up towards the root through the levels of its own kind.
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_MINMAX_HEAP) being updated
+ *      index       :   Index of the newly placed node
+ *
+ *  Returns:
+ *      (unsigned int)  Final index of the node
+*/
+unsigned int pq_mmheap_push_up(PriorityQueue *pq, unsigned int index);
+
+
+
+
+
+/*
+ *  Restore the Min-Max heap property below the given index, after the node
+ *  at that index has been replaced by a node which may violate the ordering
+ *  of its descendants (on min levels: larger, on max levels: smaller).
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_MINMAX_HEAP) being updated
+ *      index       :   Index of the replaced node
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_mmheap_trickle_down(PriorityQueue *pq, unsigned int index);
+
+
+
+
+
+/*
+ *  Restore the Min-Max heap property after the priority of the node at the
+ *  given index has been changed arbitrarily (either direction).
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_MINMAX_HEAP) being updated
+ *      index       :   Index of the changed node
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_mmheap_restore(PriorityQueue *pq, unsigned int index);
+
+
+
+
+
+/*
+ *  Returns 1 if the given index of a Min-Max heap is on a min level
+ *  (even level, the root is on level 0), 0 if it is on a max level.
+*/
+int pq_mmheap_is_min_level(unsigned int index);
+
+
+
+
+
+/*
+ *  Rebuild the whole PQnode array of the specified priority queue as
+ *  a Min-Max heap (bottom-up, in O(n) time).
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_MINMAX_HEAP) being rebuilt
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_mmheap_build(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Locate the node holding the maximum priority of a Min-Max heap.
+ *  The maximum always lives on the first max level (index 1 or 2), or at
+ *  the root if the heap holds only one node.
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_MINMAX_HEAP), must not be empty
+ *
+ *  Returns:
+ *      (unsigned int)  Index of the maximum node
+*/
+unsigned int pq_mmheap_max_index(PriorityQueue *pq);
+
+
+
+
+
+
+/*
+ *  Monotone radix heap (PQ_ENGINE_RADIX_HEAP) algorithms. The buckets are
+ *  contiguous segments of the PQnode array in decreasing bucket order, so
+ *  bucket 0, which holds the keys equal to radixLast, ends the array.
+ *  pRadixStart[b] is the first index of bucket b, which ends where bucket b - 1
+ *  starts (bucket 0 ends at the size of the queue).
+ *
+ *  Push            place the last node of the array (just appended) into its bucket,
+ *                  moving the first node of every lower bucket one segment up
+ *  Min Index       refill bucket 0 from the lowest non-empty bucket if needed,
+ *                  the minimum is then the last node of the array
+ *  Max Index       scan the highest non-empty bucket for the maximum
+ *  Remove          take the node at index out of its bucket, the array shrinks by one
+ *  Relocate        move the node at index to the bucket of its changed key
+ *
+ *  A key smaller than radixLast (on push & relocate) makes the queue fall back
+ *  to a min binary heap (pq_radix_fallback()).
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_RADIX_HEAP), must not be empty
+ *      index       :   Index of the node which is being placed or taken out
+ *
+ *  Returns:
+ *      (unsigned int)  Final index of the node (0 after a fallback), index of the extreme
+*/
+unsigned int pq_radix_push(PriorityQueue *pq, unsigned int index);
+unsigned int pq_radix_min_index(PriorityQueue *pq);
+unsigned int pq_radix_max_index(PriorityQueue *pq);
+void pq_radix_remove(PriorityQueue *pq, unsigned int index);
+void pq_radix_relocate(PriorityQueue *pq, unsigned int index);
+
+
+
+
+
+/*
+ *  Turn a radix heap into a min binary heap (PQ_ENGINE_BINARY_HEAP) of its
+ *  current nodes, after a key below radixLast showed up. The bucket bounds are
+ *  released, the heap is built in O(n) time and counted as a rebuild.
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_RADIX_HEAP) falling back
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_radix_fallback(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Pairing heap (PQ_ENGINE_PAIRING_HEAP) algorithms. The nodes never move
+ *  inside the PQnode array while they are in the heap, except that the last node
+ *  fills the slot of a removed node; pairRoot is the index of the root.
+ *
+ *  Push            link the last node of the array (just appended) with the root
+ *  Remove          take the node at index out of the heap, its children are paired
+ *                  into one tree, the array shrinks by one
+ *  Restore         re-link the node at index after its priority has changed from
+ *                  oldPriority (NULL if not known), in O(1) time if it moved towards the root
+ *  Opposite Index  locate the extreme opposite to the Heap Orientation among
+ *                  the childless nodes (unless it is known already)
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_PAIRING_HEAP), must not be empty
+ *      index       :   Index of the node which is being linked or taken out
+ *      oldPriority :   Priority of the node before the change, or NULL
+ *
+ *  Returns:
+ *      (unsigned int)  Final index of the node, index of the opposite extreme
+*/
+unsigned int pq_pheap_push(PriorityQueue *pq, unsigned int index);
+void pq_pheap_remove(PriorityQueue *pq, unsigned int index);
+void pq_pheap_restore(PriorityQueue *pq, unsigned int index, const void *oldPriority);
+unsigned int pq_pheap_opposite_index(PriorityQueue *pq);
+
+
+
+
+
+/*
+ *  Pair all the nodes of a pairing heap again towards the given orientation
+ *  (in O(n) time), and count the rebuild.
+ *
+ *  Parameters:
+ *      pq              :   The priority queue (PQ_ENGINE_PAIRING_HEAP) being re-oriented
+ *      hOrientation    :   The new Heap Orientation
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_pheap_orient(PriorityQueue *pq, enum PQ_HeapOrient_t hOrientation);
+
+
+
+
+
+/*
+ *  Meld the tree of another pairing heap of the same orientation, whose nodes
+ *  have just been appended from the given offset, with the tree of the queue.
+ *  The links are copied shifted by the offset and the two roots are linked.
+ *
+ *  Parameters:
+ *      pq          :   The priority queue (PQ_ENGINE_PAIRING_HEAP) taking the nodes
+ *      other       :   The pairing heap whose nodes were appended
+ *      offset      :   Index of the first appended node
+ *
+ *  Returns:
+ *      (void)
+*/
+void pq_pheap_meld(PriorityQueue *pq, const PriorityQueue *other, unsigned int offset);
+
+
+
+
+
+#endif
+
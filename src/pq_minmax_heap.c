@@ -0,0 +1,262 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Min-Max Heap storage engine (PQ_ENGINE_MINMAX_HEAP)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+
+
+
+
+/*  Nodes on even levels (root is level 0) are min levels, every such node
+    holds a priority not greater than any of its descendants.
+    Nodes on odd levels are max levels, every such node holds a priority
+    not less than any of its descendants.
+*/
+#define MMHEAP_PARENT(index)                (((index) - 1) / 2)
+#define MMHEAP_FIRST_CHILD(index)           (2 * (index) + 1)
+#define MMHEAP_FIRST_GRANDCHILD(index)      (4 * (index) + 3)
+
+
+
+
+
+
+int pq_mmheap_is_min_level(unsigned int index) {
+    
+    unsigned int level;
+    
+    level = 0;
+    index = index + 1;
+    while (index > 1) {
+        index = index >> 1;
+        level += 1;
+    }
+    
+    return (level & 1) == 0 ? 1 : 0;
+}
+
+
+
+
+
+/*  Compare two priorities of the heap.
+    direction is 1 for min levels and -1 for max levels, so that a negative
+    result always means the first priority belongs closer to the root.
+*/
+static int pq_mmheap_compare(PriorityQueue *pq, const void *p1, const void *p2, int direction) {
+    
+    return direction * pq_compare_priority(pq, p1, p2);
+}
+
+
+
+
+
+/*  Move the hole at index up through grandparents, which are on the same kind
+    of level, until the node fits, then store the node there
+*/
+static unsigned int pq_mmheap_push_up_grand(PriorityQueue *pq, unsigned int index,
+                                            const PQnode *pNode, PQhandle handle, int direction) {
+    
+    unsigned int grand;
+    
+    while (index > 2) {
+        grand = MMHEAP_PARENT(MMHEAP_PARENT(index));
+        if (pq_mmheap_compare(pq, pNode->priority, pq_array(pq)[grand].priority, direction) >= 0)
+            break;
+        pq_move_node(pq, index, grand);
+        index = grand;
+    }
+    
+    pq_store_node(pq, index, pNode, handle);
+    return index;
+}
+
+
+
+
+
+unsigned int pq_mmheap_push_up(PriorityQueue *pq, unsigned int index) {
+    
+    unsigned int parent;
+    int direction;
+    PQnode node;
+    PQhandle handle;
+    
+    
+    if (index == 0)
+        return 0;
+    
+    
+    /*  If the node violates the order against its direct parent (which is on
+        the opposite kind of level), it belongs to the levels of its parent
+    */
+    node = pq_array(pq)[index];
+    handle = pq_node_handle(pq, index);
+    direction = pq_mmheap_is_min_level(index) == 1 ? 1 : -1;
+    parent = MMHEAP_PARENT(index);
+    if (pq_mmheap_compare(pq, node.priority, pq_array(pq)[parent].priority, direction) > 0) {
+        pq_move_node(pq, index, parent);
+        return pq_mmheap_push_up_grand(pq, parent, &node, handle, -direction);
+    }
+    
+    return pq_mmheap_push_up_grand(pq, index, &node, handle, direction);
+}
+
+
+
+
+
+void pq_mmheap_trickle_down(PriorityQueue *pq, unsigned int index) {
+    
+    unsigned int size;
+    unsigned int child, grand, best, last, parent;
+    unsigned int candidate;
+    int direction;
+    PQnode node, swap, *pArray;
+    PQhandle handle, swapHandle;
+    
+    
+    pArray = pq_array(pq);
+    size = pq_size(pq);
+    direction = pq_mmheap_is_min_level(index) == 1 ? 1 : -1;
+    node = pArray[index];
+    handle = pq_node_handle(pq, index);
+    
+    while (1) {
+    
+        child = MMHEAP_FIRST_CHILD(index);
+        if (child >= size)
+            break;
+    
+    
+        /*  Find the best node among children and grandchildren.
+            Grandchildren of a node occupy four consecutive slots.
+        */
+        best = child;
+        if (child + 1 < size &&
+            pq_mmheap_compare(pq, pArray[child + 1].priority, pArray[best].priority, direction) < 0)
+            best = child + 1;
+    
+        grand = MMHEAP_FIRST_GRANDCHILD(index);
+        last = grand + 4 < size ? grand + 4 : size;
+        for (candidate = grand; candidate < last; candidate += 1) {
+            if (pq_mmheap_compare(pq, pArray[candidate].priority, pArray[best].priority, direction) < 0)
+                best = candidate;
+        }
+    
+        if (pq_mmheap_compare(pq, pArray[best].priority, node.priority, direction) >= 0)
+            break;
+    
+        pq_move_node(pq, index, best);
+        index = best;
+    
+    
+        /*  A child is on the opposite kind of level, we can stop here.
+            A grandchild may violate the order against its own parent, then
+            the node takes the place of that parent, and the parent continues
+            to trickle down in its place.
+        */
+        if (best < grand)
+            break;
+    
+        parent = MMHEAP_PARENT(best);
+        if (pq_mmheap_compare(pq, node.priority, pArray[parent].priority, direction) > 0) {
+            swap = pArray[parent];
+            swapHandle = pq_node_handle(pq, parent);
+            pq_store_node(pq, parent, &node, handle);
+            node = swap;
+            handle = swapHandle;
+        }
+    }
+    
+    pq_store_node(pq, index, &node, handle);
+    return;
+}
+
+
+
+
+
+void pq_mmheap_restore(PriorityQueue *pq, unsigned int index) {
+    
+    unsigned int parent;
+    int direction;
+    PQnode node;
+    PQhandle handle;
+    
+    
+    direction = pq_mmheap_is_min_level(index) == 1 ? 1 : -1;
+    node = pq_array(pq)[index];
+    handle = pq_node_handle(pq, index);
+    
+    
+    /*  The node moved past its direct parent: it goes up through the levels
+        of its parent, while the former parent must sink below this index
+    */
+    if (index > 0) {
+        parent = MMHEAP_PARENT(index);
+        if (pq_mmheap_compare(pq, node.priority, pq_array(pq)[parent].priority, direction) > 0) {
+            pq_move_node(pq, index, parent);
+            pq_mmheap_push_up_grand(pq, parent, &node, handle, -direction);
+            pq_mmheap_trickle_down(pq, index);
+            return;
+        }
+    }
+    
+    
+    /*  Otherwise the node either moves up through its grandparents,
+        or it stays and possibly has to move down
+    */
+    if (pq_mmheap_push_up_grand(pq, index, &node, handle, direction) != index)
+        return;
+    
+    pq_mmheap_trickle_down(pq, index);
+    return;
+}
+
+
+
+
+
+void pq_mmheap_build(PriorityQueue *pq) {
+    
+    unsigned int index;
+    
+    
+    /* Trickle down every internal node, starting from the last one */
+    index = pq_size(pq) / 2;
+    while (index > 0) {
+        index -= 1;
+        pq_mmheap_trickle_down(pq, index);
+    }
+    
+    return;
+}
+
+
+
+
+
+unsigned int pq_mmheap_max_index(PriorityQueue *pq) {
+    
+    if (pq_size(pq) == 1)
+        return 0;
+    if (pq_size(pq) == 2)
+        return 1;
+    
+    return pq_mmheap_compare(pq, pq_array(pq)[1].priority, pq_array(pq)[2].priority, 1) >= 0 ? 1 : 2;
+}
+
@@ -1,252 +1,507 @@
-
-
-/************************************************************************************
-    Implementation of Double Ended Priority Queue ADT Mutation Algorithms
-    Author:             Ashis Kumar Das
-    Email:              akd.bracu@gmail.com
-    GitHub:             https://github.com/AKD92
-*************************************************************************************/
-
-
-
-
-
-
-
-#include "pq.h"
-#include "pq_internal.h"
-#include <stdlib.h>
-#include <string.h>
-#include <bh.h>
-
-
-
-
-
-
-
-
-
-int pq_insert_with_priority(PriorityQueue *pq, const void *elem, const void *priority) {
-    
-    BiHeap heap;
-    PQnode *pNode;
-    int opExpand;
-    int (*fpHeapSwimAlgorithm) (BiHeap *heap, unsigned int index);
-    
-    
-    /* Check for invalid function arguments */
-    if (pq == 0 || priority == 0 || elem == 0)
-        return -1;
-    
-    
-    /* Expand internal array if the array is full */
-    /* Expand operation can fail due to unavailability of additional memory */
-    if (pq_size(pq) == pq_capacity(pq)) {
-        opExpand = pq_expand_capacity(pq);
-        if (opExpand != 0)
-            return -2;
-    }
-    
-    
-    /* Select which Heap Orientation this PQ is currently configured to */
-    /* We insert into this PQ according to the rules of current Heap Orientation */
-    switch (pq_heap_orientation(pq)) {
-        case PQ_HEAP_MAX:
-            fpHeapSwimAlgorithm = bh_swim_heavy;
-            break;
-        case PQ_HEAP_MIN:
-            fpHeapSwimAlgorithm = bh_swim_light;
-            break;
-        default:
-            fpHeapSwimAlgorithm = 0;
-            return -1;
-    }
-    
-    
-    /* Determine last PQnode as our new node where we insert data */
-    pNode = pq_array(pq) + pq_size(pq);
-    pNode->priority = (void *) priority;
-    pNode->elem = (void *) elem;
-    pNode->fpComparePriority = pq->fpComparePriority;
-    pq_size(pq) = pq_size(pq) + 1;
-    
-    if (pq_size(pq) == 1)
-        return 0;
-    
-    /*  Restore binary heap property.
-        Run the chosen algorithm / operation.
-    */
-    bh_init(&heap, (void *) pq_array(pq), pq_size(pq), sizeof(PQnode), pq_compare_node);
-    fpHeapSwimAlgorithm(&heap, pq_size(pq) - 1);
-    bh_destroy(&heap);
-    
-    return 0;
-}
-
-
-
-
-
-int pq_pull_minimum(PriorityQueue *pq, void **priority, void **elem) {
-    
-    BiHeap heap;
-    PQnode *pNodeMin;
-    
-    
-    /* Check for invalid function arguments */
-    if (pq == 0 || priority == 0 || elem == 0)
-        return -1;
-    if (pq_size(pq) == 0)
-        return -1;
-    
-    
-    /* Detect which Heap Orientation this PQ is currently configured to */
-    /* If current Heap Orientation is a MAX HEAP, transform it to a MIN HEAP */
-    if (pq_heap_orientation(pq) == PQ_HEAP_MAX) {
-        bh_init(&heap, (void *) pq_array(pq), pq_size(pq), sizeof(PQnode), pq_compare_node);
-        bh_build_minheap(&heap);
-        bh_destroy(&heap);
-        pq_heap_orientation(pq) = PQ_HEAP_MIN;
-    }
-    
-    
-    /* Access data for transfering to the caller */
-    pNodeMin = pq_array(pq) + 0;
-    *priority = pNodeMin->priority;
-    *elem = pNodeMin->elem;
-    pq_size(pq) = pq_size(pq) - 1;
-    
-    if (pq_size(pq) == 0)
-        return 0;
-    
-    /*  Restore binary heap property.
-        Run the chosen algorithm / operation.
-    */
-    bh_init(&heap, (void *) pq_array(pq), pq_size(pq) + 1, sizeof(PQnode), pq_compare_node);
-    bh_swap(0, bh_size(&heap) - 1, &heap);
-    bh_size(&heap) = bh_size(&heap) - 1;
-    bh_sink_heavy(&heap, 0);
-    bh_destroy(&heap);
-    
-    return 0;
-}
-
-
-
-
-
-int pq_peek_minimum(PriorityQueue *pq, void **priority, void **elem) {
-    
-    BiHeap heap;
-    PQnode *pNodeMin;
-    
-    
-    /* Check for invalid function arguments */
-    if (pq == 0 || priority == 0 || elem == 0)
-        return -1;
-    if (pq_size(pq) == 0)
-        return -1;
-    
-    
-    /* Detect which Heap Orientation this PQ is currently configured to */
-    /* If current Heap Orientation is a MAX HEAP, transform it to a MIN HEAP */
-    if (pq_heap_orientation(pq) == PQ_HEAP_MAX) {
-        bh_init(&heap, (void *) pq_array(pq), pq_size(pq), sizeof(PQnode), pq_compare_node);
-        bh_build_minheap(&heap);
-        bh_destroy(&heap);
-        pq_heap_orientation(pq) = PQ_HEAP_MIN;
-    }
-    
-    
-    /* Access data for transfering to the caller */
-    pNodeMin = pq_array(pq) + 0;
-    *priority = pNodeMin->priority;
-    *elem = pNodeMin->elem;
-    
-    return 0;
-}
-
-
-
-
-
-int pq_pull_maximum(PriorityQueue *pq, void **priority, void **elem) {
-    
-    BiHeap heap;
-    PQnode *pNodeMax;
-    
-    
-    /* Check for invalid function arguments */
-    if (pq == 0 || priority == 0 || elem == 0)
-        return -1;
-    if (pq_size(pq) == 0)
-        return -1;
-    
-    
-    /* Detect which Heap Orientation this PQ is currently configured to */
-    /* If current Heap Orientation is a MIN HEAP, transform it to a MAX HEAP */
-    if (pq_heap_orientation(pq) == PQ_HEAP_MIN) {
-        bh_init(&heap, (void *) pq_array(pq), pq_size(pq), sizeof(PQnode), pq_compare_node);
-        bh_build_maxheap(&heap);
-        bh_destroy(&heap);
-        pq_heap_orientation(pq) = PQ_HEAP_MAX;
-    }
-    
-    
-    /* Access data for transfering to the caller */
-    pNodeMax = pq_array(pq) + 0;
-    *priority = pNodeMax->priority;
-    *elem = pNodeMax->elem;
-    pq_size(pq) = pq_size(pq) - 1;
-    
-    if (pq_size(pq) == 0)
-        return 0;
-    
-    /*  Restore binary heap property.
-        Run the chosen algorithm / operation.
-    */
-    bh_init(&heap, (void *) pq_array(pq), pq_size(pq) + 1, sizeof(PQnode), pq_compare_node);
-    bh_swap(0, bh_size(&heap) - 1, &heap);
-    bh_size(&heap) = bh_size(&heap) - 1;
-    bh_sink_light(&heap, 0);
-    bh_destroy(&heap);
-    
-    return 0;
-}
-
-
-
-
-
-int pq_peek_maximum(PriorityQueue *pq, void **priority, void **elem) {
-    
-    BiHeap heap;
-    PQnode *pNodeMax;
-    
-    
-    /* Check for invalid function arguments */
-    if (pq == 0 || priority == 0 || elem == 0)
-        return -1;
-    if (pq_size(pq) == 0)
-        return -1;
-    
-    
-    /* Detect which Heap Orientation this PQ is currently configured to */
-    /* If current Heap Orientation is a MIN HEAP, transform it to a MAX HEAP */
-    if (pq_heap_orientation(pq) == PQ_HEAP_MIN) {
-        bh_init(&heap, (void *) pq_array(pq), pq_size(pq), sizeof(PQnode), pq_compare_node);
-        bh_build_maxheap(&heap);
-        bh_destroy(&heap);
-        pq_heap_orientation(pq) = PQ_HEAP_MAX;
-    }
-    
-    
-    /* Access data for transfering to the caller */
-    pNodeMax = pq_array(pq) + 0;
-    *priority = pNodeMax->priority;
-    *elem = pNodeMax->elem;
-    
-    return 0;
-}
-
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT Mutation Algorithms
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+
+
+
+
+
+/*  Remove the extreme opposite to the Heap Orientation (binary & d-ary heap
+    engines) without re-orienting the heap. It is found among the leaves, the
+    last node fills its place and moves up or down from there.
+*/
+static void pq_bheap_pull_opposite(PriorityQueue *pq, void **priority, void **elem) {
+    
+    PQnode *pNode;
+    unsigned int index;
+    
+    
+    index = pq_bheap_opposite_index(pq);
+    pNode = pq_array(pq) + index;
+    *priority = pNode->priority;
+    *elem = pNode->elem;
+    pq_handle_release(pq, index);
+    pq_size(pq) = pq_size(pq) - 1;
+    
+    if (index != pq_size(pq)) {
+        pq_move_node(pq, index, pq_size(pq));
+        pq_restore_node(pq, index);
+    }
+    pq_opposite_forget(pq);
+    
+    return;
+}
+
+
+
+
+
+/*  Locate the node to pull from the given end of a pairing heap: the root if the
+    heap is oriented towards that end, otherwise the opposite extreme, until
+    enough pulls in a row from that end justify pairing the heap the other way.
+*/
+static unsigned int pq_pheap_pull_index(PriorityQueue *pq, enum PQ_HeapOrient_t hOrientation) {
+    
+    if (pq_heap_orientation(pq) != hOrientation) {
+        pq->oppositePulls += 1;
+        if (pq->oppositePulls < PQ_REORIENT_PULLS)
+            return pq_pheap_opposite_index(pq);
+        pq_pheap_orient(pq, hOrientation);
+    }
+    pq->oppositePulls = 0;
+    
+    return pq->pairRoot;
+}
+
+
+
+
+
+
+int pq_insert_with_priority(PriorityQueue *pq, const void *elem, const void *priority) {
+    
+    return pq_insert_with_handle(pq, elem, priority, 0);
+}
+
+
+
+
+
+int pq_insert_with_handle(PriorityQueue *pq, const void *elem, const void *priority, PQhandle *handle) {
+    
+    PQnode *pNode;
+    unsigned int index;
+    int opExpand;
+    unsigned int (*fpHeapSwimAlgorithm) (PriorityQueue *pq, unsigned int index);
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    
+    /* Select which Heap Orientation this PQ is currently configured to */
+    /* We insert into this PQ according to the rules of current Heap Orientation */
+    /* A Min-Max Heap does not depend on any Heap Orientation */
+    if (pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP) {
+        fpHeapSwimAlgorithm = pq_mmheap_push_up;
+    }
+    else if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP) {
+        fpHeapSwimAlgorithm = pq_radix_push;
+    }
+    else if (pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP) {
+        fpHeapSwimAlgorithm = pq_pheap_push;
+    }
+    else {
+        switch (pq_heap_orientation(pq)) {
+            case PQ_HEAP_MAX:
+                fpHeapSwimAlgorithm = pq_bheap_swim_heavy;
+                break;
+            case PQ_HEAP_MIN:
+                fpHeapSwimAlgorithm = pq_bheap_swim_light;
+                break;
+            default:
+                fpHeapSwimAlgorithm = 0;
+                return -1;
+        }
+    }
+    
+    
+    /* Expand internal array if the array is full */
+    /* Expand operation can fail due to unavailability of additional memory */
+    if (pq_size(pq) == pq_capacity(pq)) {
+        opExpand = pq_expand_capacity(pq);
+        if (opExpand != 0)
+            return -2;
+    }
+    
+    
+    /* The first request of a handle creates the position map */
+    /* Then the new node receives its handle (or none) before it moves */
+    if (handle != 0 && pq->pNodeHandle == 0) {
+        if (pq_handle_map_create(pq) != 0)
+            return -2;
+    }
+    if (pq_handle_acquire(pq, pq_size(pq), handle) != 0)
+        return -2;
+    
+    
+    /* Determine last PQnode as our new node where we insert data */
+    pNode = pq_array(pq) + pq_size(pq);
+    pNode->priority = (void *) priority;
+    pNode->elem = (void *) elem;
+    pq_size(pq) = pq_size(pq) + 1;
+    
+    /*  Restore heap property.
+        Run the chosen algorithm / operation.
+        Radix & pairing heaps place even their first node, and track the rest themselves.
+    */
+    index = pq_size(pq) - 1;
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP || pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP) {
+        fpHeapSwimAlgorithm(pq, index);
+        return 0;
+    }
+    if (index != 0)
+        index = fpHeapSwimAlgorithm(pq, index);
+    
+    /* The new node may be the new opposite extreme, or may have moved it down */
+    if (pq_is_oriented(pq))
+        pq_bheap_opposite_track(pq, index);
+    
+    return 0;
+}
+
+
+
+
+
+int pq_pull_minimum(PriorityQueue *pq, void **priority, void **elem) {
+    
+    PQnode *pNodeMin;
+    unsigned int index;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priority == 0 || elem == 0)
+        return -1;
+    if (pq_size(pq) == 0)
+        return -1;
+    
+    
+    /* In a Min-Max Heap the minimum is always the root */
+    /* The last node takes its place and trickles down */
+    if (pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP) {
+        pNodeMin = pq_array(pq) + 0;
+        *priority = pNodeMin->priority;
+        *elem = pNodeMin->elem;
+        pq_handle_release(pq, 0);
+        pq_size(pq) = pq_size(pq) - 1;
+        if (pq_size(pq) != 0) {
+            pq_move_node(pq, 0, pq_size(pq));
+            pq_mmheap_trickle_down(pq, 0);
+        }
+        goto PULL_END;
+    }
+    
+    
+    /* A radix heap refills its bucket 0 if needed, the minimum then ends the array */
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP) {
+        index = pq_radix_min_index(pq);
+        pNodeMin = pq_array(pq) + index;
+        *priority = pNodeMin->priority;
+        *elem = pNodeMin->elem;
+        pq_handle_release(pq, index);
+        pq_radix_remove(pq, index);
+        goto PULL_END;
+    }
+    
+    
+    /* A pairing heap gives its minimum from the root or from a scan of the childless nodes */
+    if (pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP) {
+        index = pq_pheap_pull_index(pq, PQ_HEAP_MIN);
+        pNodeMin = pq_array(pq) + index;
+        *priority = pNodeMin->priority;
+        *elem = pNodeMin->elem;
+        pq_handle_release(pq, index);
+        pq_pheap_remove(pq, index);
+        goto PULL_END;
+    }
+    
+    
+    /* Detect which Heap Orientation this PQ is currently configured to */
+    /* A MAX HEAP gives its minimum from a leaf, until enough pulls in a row */
+    /* From that end justify transforming it to a MIN HEAP */
+    if (pq_heap_orientation(pq) == PQ_HEAP_MAX) {
+        pq->oppositePulls += 1;
+        if (pq->oppositePulls < PQ_REORIENT_PULLS) {
+            pq_bheap_pull_opposite(pq, priority, elem);
+            goto PULL_END;
+        }
+        pq_bheap_orient(pq, PQ_HEAP_MIN);
+    }
+    pq->oppositePulls = 0;
+    
+    
+    /* Access data for transfering to the caller */
+    pNodeMin = pq_array(pq) + 0;
+    *priority = pNodeMin->priority;
+    *elem = pNodeMin->elem;
+    pq_handle_release(pq, 0);
+    pq_size(pq) = pq_size(pq) - 1;
+    pq_opposite_forget(pq);
+    
+    if (pq_size(pq) == 0)
+        goto PULL_END;
+    
+    /*  Restore binary heap property.
+        Run the chosen algorithm / operation.
+    */
+    pq_move_node(pq, 0, pq_size(pq));
+    pq_bheap_sink_heavy(pq, 0);
+    
+    
+    /* Give memory back after a burst has drained */
+    PULL_END:
+    if (pq_should_shrink(pq))
+        pq_shrink_capacity(pq);
+    
+    return 0;
+}
+
+
+
+
+
+int pq_peek_minimum(PriorityQueue *pq, void **priority, void **elem) {
+    
+    PQnode *pNodeMin;
+    unsigned int index;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priority == 0 || elem == 0)
+        return -1;
+    if (pq_size(pq) == 0)
+        return -1;
+    
+    
+    /* Detect which Heap Orientation this PQ is currently configured to */
+    /* A MAX HEAP keeps its minimum in a leaf, which is located once and remembered */
+    /* A Min-Max Heap always keeps the minimum at the root */
+    /* A radix heap keeps it at the end of the array, once bucket 0 is refilled */
+    index = 0;
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP)
+        index = pq_radix_min_index(pq);
+    else if (pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP)
+        index = pq_heap_orientation(pq) == PQ_HEAP_MIN ? pq->pairRoot : pq_pheap_opposite_index(pq);
+    else if (pq_is_oriented(pq) && pq_heap_orientation(pq) == PQ_HEAP_MAX)
+        index = pq_bheap_opposite_index(pq);
+    
+    
+    /* Access data for transfering to the caller */
+    pNodeMin = pq_array(pq) + index;
+    *priority = pNodeMin->priority;
+    *elem = pNodeMin->elem;
+    
+    return 0;
+}
+
+
+
+
+
+int pq_pull_maximum(PriorityQueue *pq, void **priority, void **elem) {
+    
+    PQnode *pNodeMax;
+    unsigned int index;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priority == 0 || elem == 0)
+        return -1;
+    if (pq_size(pq) == 0)
+        return -1;
+    
+    
+    /* In a Min-Max Heap the maximum is one of the children of the root */
+    /* The last node takes its place and is restored from there */
+    if (pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP) {
+        index = pq_mmheap_max_index(pq);
+        pNodeMax = pq_array(pq) + index;
+        *priority = pNodeMax->priority;
+        *elem = pNodeMax->elem;
+        pq_handle_release(pq, index);
+        pq_size(pq) = pq_size(pq) - 1;
+        if (index != pq_size(pq)) {
+            pq_move_node(pq, index, pq_size(pq));
+            pq_mmheap_restore(pq, index);
+        }
+        goto PULL_END;
+    }
+    
+    
+    /* A radix heap finds its maximum in the highest non-empty bucket */
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP) {
+        index = pq_radix_max_index(pq);
+        pNodeMax = pq_array(pq) + index;
+        *priority = pNodeMax->priority;
+        *elem = pNodeMax->elem;
+        pq_handle_release(pq, index);
+        pq_radix_remove(pq, index);
+        goto PULL_END;
+    }
+    
+    
+    /* A pairing heap gives its maximum from the root or from a scan of the childless nodes */
+    if (pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP) {
+        index = pq_pheap_pull_index(pq, PQ_HEAP_MAX);
+        pNodeMax = pq_array(pq) + index;
+        *priority = pNodeMax->priority;
+        *elem = pNodeMax->elem;
+        pq_handle_release(pq, index);
+        pq_pheap_remove(pq, index);
+        goto PULL_END;
+    }
+    
+    
+    /* Detect which Heap Orientation this PQ is currently configured to */
+    /* A MIN HEAP gives its maximum from a leaf, until enough pulls in a row */
+    /* From that end justify transforming it to a MAX HEAP */
+    if (pq_heap_orientation(pq) == PQ_HEAP_MIN) {
+        pq->oppositePulls += 1;
+        if (pq->oppositePulls < PQ_REORIENT_PULLS) {
+            pq_bheap_pull_opposite(pq, priority, elem);
+            goto PULL_END;
+        }
+        pq_bheap_orient(pq, PQ_HEAP_MAX);
+    }
+    pq->oppositePulls = 0;
+    
+    
+    /* Access data for transfering to the caller */
+    pNodeMax = pq_array(pq) + 0;
+    *priority = pNodeMax->priority;
+    *elem = pNodeMax->elem;
+    pq_handle_release(pq, 0);
+    pq_size(pq) = pq_size(pq) - 1;
+    pq_opposite_forget(pq);
+    
+    if (pq_size(pq) == 0)
+        goto PULL_END;
+    
+    /*  Restore binary heap property.
+        Run the chosen algorithm / operation.
+    */
+    pq_move_node(pq, 0, pq_size(pq));
+    pq_bheap_sink_light(pq, 0);
+    
+    
+    /* Give memory back after a burst has drained */
+    PULL_END:
+    if (pq_should_shrink(pq))
+        pq_shrink_capacity(pq);
+    
+    return 0;
+}
+
+
+
+
+
+int pq_peek_maximum(PriorityQueue *pq, void **priority, void **elem) {
+    
+    PQnode *pNodeMax;
+    unsigned int index;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priority == 0 || elem == 0)
+        return -1;
+    if (pq_size(pq) == 0)
+        return -1;
+    
+    
+    /* In a Min-Max Heap the maximum is one of the children of the root */
+    if (pq_engine(pq) == PQ_ENGINE_MINMAX_HEAP) {
+        pNodeMax = pq_array(pq) + pq_mmheap_max_index(pq);
+        *priority = pNodeMax->priority;
+        *elem = pNodeMax->elem;
+        return 0;
+    }
+    
+    
+    /* Detect which Heap Orientation this PQ is currently configured to */
+    /* A MIN HEAP keeps its maximum in a leaf, which is located once and remembered */
+    /* A radix heap scans its highest non-empty bucket */
+    index = 0;
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP)
+        index = pq_radix_max_index(pq);
+    else if (pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP)
+        index = pq_heap_orientation(pq) == PQ_HEAP_MAX ? pq->pairRoot : pq_pheap_opposite_index(pq);
+    else if (pq_heap_orientation(pq) == PQ_HEAP_MIN)
+        index = pq_bheap_opposite_index(pq);
+    
+    
+    /* Access data for transfering to the caller */
+    pNodeMax = pq_array(pq) + index;
+    *priority = pNodeMax->priority;
+    *elem = pNodeMax->elem;
+    
+    return 0;
+}
+
+
+
+
+
+int pq_remove(PriorityQueue *pq, PQhandle handle, void **priority, void **elem) {
+    
+    unsigned int index;
+    PQnode *pNode;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0)
+        return -1;
+    
+    
+    /* The position map gives the location of the element directly */
+    if (pq_handle_lookup(pq, handle, &index) != 0)
+        return -2;
+    
+    
+    /* Access data for transfering to the caller */
+    pNode = pq_array(pq) + index;
+    if (priority != 0)
+        *priority = pNode->priority;
+    if (elem != 0)
+        *elem = pNode->elem;
+    pq_handle_release(pq, index);
+    
+    /*  The last node fills the hole, then it moves up or down
+        according to the current storage engine.
+        A radix heap closes the hole bucket by bucket instead,
+        a pairing heap pairs the children of the node.
+    */
+    if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP) {
+        pq_radix_remove(pq, index);
+    }
+    else if (pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP) {
+        pq_pheap_remove(pq, index);
+    }
+    else {
+        pq_size(pq) = pq_size(pq) - 1;
+        pq_opposite_forget(pq);
+        if (index != pq_size(pq)) {
+            pq_move_node(pq, index, pq_size(pq));
+            pq_restore_node(pq, index);
+        }
+    }
+    
+    if (pq_should_shrink(pq))
+        pq_shrink_capacity(pq);
+    
+    return 0;
+}
+
+
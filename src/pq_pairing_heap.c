@@ -0,0 +1,429 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Pairing Heap storage engine (PQ_ENGINE_PAIRING_HEAP)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+
+
+
+
+/*  Every node of the tree precedes its children by the Heap Orientation (not
+    greater than them in a min heap). The children of a node form a list through
+    their sibling links, the first child points back to its parent through prev.
+    The links are indices into the PQnode array, which is the pool of the nodes.
+*/
+#define pq_pheap_direction(pq)              (pq_heap_orientation(pq) == PQ_HEAP_MIN ? 1 : -1)
+#define pq_pheap_compare(pq, index1, index2) \
+                                            (pq_pheap_direction(pq) * pq_compare_node((pq), \
+                                                pq_array(pq) + (index1), pq_array(pq) + (index2)))
+#define pq_pheap_shift(link, offset)        ((link) == PQ_INDEX_NONE ? PQ_INDEX_NONE : (link) + (offset))
+
+
+
+
+
+
+/*  Make the tree of root1 and the tree of root2 one tree, whose root is returned.
+    The root which does not precede the other becomes the first child of it.
+*/
+static unsigned int pq_pheap_link(PriorityQueue *pq, unsigned int root1, unsigned int root2) {
+    
+    PQpairLink *pLink;
+    unsigned int parent, child;
+    
+    pLink = pq->pPairLink;
+    if (pq_pheap_compare(pq, root1, root2) <= 0) {
+        parent = root1;
+        child = root2;
+    }
+    else {
+        parent = root2;
+        child = root1;
+    }
+    
+    pLink[child].sibling = pLink[parent].child;
+    pLink[child].prev = parent;
+    if (pLink[parent].child != PQ_INDEX_NONE)
+        pLink[pLink[parent].child].prev = child;
+    pLink[parent].child = child;
+    
+    return parent;
+}
+
+
+
+
+
+/*  Detach the subtree of a node which is not the root from its parent */
+static void pq_pheap_cut(PriorityQueue *pq, unsigned int index) {
+    
+    PQpairLink *pLink;
+    unsigned int prev, sibling;
+    
+    pLink = pq->pPairLink;
+    prev = pLink[index].prev;
+    sibling = pLink[index].sibling;
+    
+    if (pLink[prev].child == index)
+        pLink[prev].child = sibling;
+    else
+        pLink[prev].sibling = sibling;
+    if (sibling != PQ_INDEX_NONE)
+        pLink[sibling].prev = prev;
+    
+    pLink[index].prev = PQ_INDEX_NONE;
+    pLink[index].sibling = PQ_INDEX_NONE;
+    
+    return;
+}
+
+
+
+
+
+/*  Two-pass pairing of a list of trees (the children of a removed node):
+    link them in pairs from left to right, then link the pairs from right
+    to left into one tree. Returns its root, or PQ_INDEX_NONE for an empty list.
+*/
+static unsigned int pq_pheap_pair(PriorityQueue *pq, unsigned int first) {
+    
+    PQpairLink *pLink;
+    unsigned int tree, other, next, pairs, root;
+    
+    
+    if (first == PQ_INDEX_NONE)
+        return PQ_INDEX_NONE;
+    
+    /* The first pass stacks the pairs through their sibling links */
+    pLink = pq->pPairLink;
+    pairs = PQ_INDEX_NONE;
+    for (tree = first; tree != PQ_INDEX_NONE; tree = next) {
+        other = pLink[tree].sibling;
+        if (other == PQ_INDEX_NONE) {
+            next = PQ_INDEX_NONE;
+            root = tree;
+        }
+        else {
+            next = pLink[other].sibling;
+            root = pq_pheap_link(pq, tree, other);
+        }
+        pLink[root].sibling = pairs;
+        pairs = root;
+    }
+    
+    /* The second pass pops them, the last pair first */
+    root = pairs;
+    for (tree = pLink[root].sibling; tree != PQ_INDEX_NONE; tree = next) {
+        next = pLink[tree].sibling;
+        root = pq_pheap_link(pq, root, tree);
+    }
+    
+    pLink[root].sibling = PQ_INDEX_NONE;
+    pLink[root].prev = PQ_INDEX_NONE;
+    
+    return root;
+}
+
+
+
+
+
+/*  Multi-pass pairing of a list of trees: link them in pairs, round after round,
+    until one tree is left. Pairing n single nodes this way takes n - 1 links and
+    gives a root with about log(n) children.
+*/
+static unsigned int pq_pheap_pair_rounds(PriorityQueue *pq, unsigned int first) {
+    
+    PQpairLink *pLink;
+    unsigned int tree, other, next, head, tail, root;
+    
+    
+    pLink = pq->pPairLink;
+    while (pLink[first].sibling != PQ_INDEX_NONE) {
+        head = PQ_INDEX_NONE;
+        tail = PQ_INDEX_NONE;
+        for (tree = first; tree != PQ_INDEX_NONE; tree = next) {
+            other = pLink[tree].sibling;
+            if (other == PQ_INDEX_NONE) {
+                next = PQ_INDEX_NONE;
+                root = tree;
+            }
+            else {
+                next = pLink[other].sibling;
+                root = pq_pheap_link(pq, tree, other);
+            }
+            pLink[root].sibling = PQ_INDEX_NONE;
+            if (tail == PQ_INDEX_NONE)
+                head = root;
+            else
+                pLink[tail].sibling = root;
+            tail = root;
+        }
+        first = head;
+    }
+    
+    pLink[first].prev = PQ_INDEX_NONE;
+    
+    return first;
+}
+
+
+
+
+
+/*  Move the node at src (the last one) into the unused slot dst, together with
+    its links, and point its parent, siblings and first child to the new slot.
+*/
+static void pq_pheap_move(PriorityQueue *pq, unsigned int dst, unsigned int src) {
+    
+    PQpairLink *pLink;
+    unsigned int prev;
+    
+    pLink = pq->pPairLink;
+    pq_move_node(pq, dst, src);
+    pLink[dst] = pLink[src];
+    
+    prev = pLink[dst].prev;
+    if (prev != PQ_INDEX_NONE) {
+        if (pLink[prev].child == src)
+            pLink[prev].child = dst;
+        else
+            pLink[prev].sibling = dst;
+    }
+    if (pLink[dst].sibling != PQ_INDEX_NONE)
+        pLink[pLink[dst].sibling].prev = dst;
+    if (pLink[dst].child != PQ_INDEX_NONE)
+        pLink[pLink[dst].child].prev = dst;
+    
+    if (pq->pairRoot == src)
+        pq->pairRoot = dst;
+    if (pq->oppositeIndex == src)
+        pq->oppositeIndex = dst;
+    
+    return;
+}
+
+
+
+
+
+unsigned int pq_pheap_push(PriorityQueue *pq, unsigned int index) {
+    
+    PQpairLink *pLink;
+    
+    
+    pLink = pq->pPairLink;
+    pLink[index].child = PQ_INDEX_NONE;
+    pLink[index].sibling = PQ_INDEX_NONE;
+    pLink[index].prev = PQ_INDEX_NONE;
+    
+    /* A single node is both extremes */
+    if (pq->pairRoot == PQ_INDEX_NONE) {
+        pq->pairRoot = index;
+        pq->oppositeIndex = index;
+        return index;
+    }
+    
+    pq->pairRoot = pq_pheap_link(pq, pq->pairRoot, index);
+    
+    /* The new node may be the new opposite extreme, no other node has moved */
+    if (pq->oppositeIndex != PQ_INDEX_NONE && pq_pheap_compare(pq, index, pq->oppositeIndex) > 0)
+        pq->oppositeIndex = index;
+    
+    return index;
+}
+
+
+
+
+
+void pq_pheap_remove(PriorityQueue *pq, unsigned int index) {
+    
+    PQpairLink *pLink;
+    unsigned int children;
+    
+    
+    /* The children of the node become one tree, which takes its place */
+    pLink = pq->pPairLink;
+    children = pq_pheap_pair(pq, pLink[index].child);
+    if (index == pq->pairRoot) {
+        pq->pairRoot = children;
+    }
+    else {
+        pq_pheap_cut(pq, index);
+        if (children != PQ_INDEX_NONE)
+            pq->pairRoot = pq_pheap_link(pq, pq->pairRoot, children);
+    }
+    
+    if (pq->oppositeIndex == index)
+        pq_opposite_forget(pq);
+    
+    
+    /* The last node fills the slot, so that the nodes stay contiguous */
+    pq_size(pq) -= 1;
+    if (index != pq_size(pq))
+        pq_pheap_move(pq, index, pq_size(pq));
+    
+    return;
+}
+
+
+
+
+
+void pq_pheap_restore(PriorityQueue *pq, unsigned int index, const void *oldPriority) {
+    
+    PQpairLink *pLink;
+    unsigned int child, children;
+    int isCloser, isViolated;
+    
+    
+    pq_opposite_forget(pq);
+    
+    
+    /* A priority which moved towards the root (decrease-key of a min heap) */
+    /* Still precedes all the children, only the parent may be violated */
+    pLink = pq->pPairLink;
+    isCloser = 0;
+    if (oldPriority != 0)
+        isCloser = pq_pheap_direction(pq) * pq_compare_priority(pq, pq_array(pq)[index].priority,
+                                                                 oldPriority) <= 0 ? 1 : 0;
+    
+    isViolated = 0;
+    if (isCloser == 0) {
+        for (child = pLink[index].child; child != PQ_INDEX_NONE; child = pLink[child].sibling) {
+            if (pq_pheap_compare(pq, child, index) < 0) {
+                isViolated = 1;
+                break;
+            }
+        }
+    }
+    
+    
+    /*  The subtree of the node is cut from its parent and linked with the root,
+        a node which no longer precedes its children leaves them behind first.
+    */
+    if (index != pq->pairRoot)
+        pq_pheap_cut(pq, index);
+    else if (isViolated == 0)
+        return;
+    else
+        pq->pairRoot = PQ_INDEX_NONE;
+    
+    if (isViolated == 1) {
+        children = pq_pheap_pair(pq, pLink[index].child);
+        pLink[index].child = PQ_INDEX_NONE;
+        pq->pairRoot = pq->pairRoot == PQ_INDEX_NONE ? children :
+                            pq_pheap_link(pq, pq->pairRoot, children);
+    }
+    pq->pairRoot = pq_pheap_link(pq, pq->pairRoot, index);
+    
+    return;
+}
+
+
+
+
+
+unsigned int pq_pheap_opposite_index(PriorityQueue *pq) {
+    
+    PQpairLink *pLink;
+    unsigned int index, best;
+    
+    
+    if (pq->oppositeIndex != PQ_INDEX_NONE)
+        return pq->oppositeIndex;
+    
+    
+    /* A node with children is preceded by them, so the extreme has no children */
+    pLink = pq->pPairLink;
+    best = PQ_INDEX_NONE;
+    for (index = 0; index < pq_size(pq); index += 1) {
+        if (pLink[index].child != PQ_INDEX_NONE)
+            continue;
+        if (best == PQ_INDEX_NONE || pq_pheap_compare(pq, index, best) > 0)
+            best = index;
+    }
+    
+    pq->oppositeIndex = best;
+    pq->leafScanCount += 1;
+    
+    return best;
+}
+
+
+
+
+
+void pq_pheap_meld(PriorityQueue *pq, const PriorityQueue *other, unsigned int offset) {
+    
+    PQpairLink *pLink;
+    const PQpairLink *pOther;
+    unsigned int index, root, opposite;
+    
+    
+    pLink = pq->pPairLink + offset;
+    pOther = other->pPairLink;
+    for (index = 0; index < pq_size(pq) - offset; index += 1) {
+        pLink[index].child = pq_pheap_shift(pOther[index].child, offset);
+        pLink[index].sibling = pq_pheap_shift(pOther[index].sibling, offset);
+        pLink[index].prev = pq_pheap_shift(pOther[index].prev, offset);
+    }
+    root = other->pairRoot + offset;
+    opposite = pq_pheap_shift(other->oppositeIndex, offset);
+    
+    if (pq->pairRoot == PQ_INDEX_NONE) {
+        pq->pairRoot = root;
+        pq->oppositeIndex = opposite;
+        return;
+    }
+    pq->pairRoot = pq_pheap_link(pq, pq->pairRoot, root);
+    
+    
+    /* The opposite extreme is kept when it is known in both heaps */
+    if (pq->oppositeIndex == PQ_INDEX_NONE || opposite == PQ_INDEX_NONE)
+        pq_opposite_forget(pq);
+    else if (pq_pheap_compare(pq, opposite, pq->oppositeIndex) > 0)
+        pq->oppositeIndex = opposite;
+    
+    return;
+}
+
+
+
+
+
+void pq_pheap_orient(PriorityQueue *pq, enum PQ_HeapOrient_t hOrientation) {
+    
+    PQpairLink *pLink;
+    unsigned int index;
+    
+    
+    /* Every node becomes a tree of its own, then all of them are paired again */
+    pq_heap_orientation(pq) = hOrientation;
+    pLink = pq->pPairLink;
+    for (index = 0; index < pq_size(pq); index += 1) {
+        pLink[index].child = PQ_INDEX_NONE;
+        pLink[index].sibling = index + 1 < pq_size(pq) ? index + 1 : PQ_INDEX_NONE;
+        pLink[index].prev = PQ_INDEX_NONE;
+    }
+    pq->pairRoot = pq_size(pq) == 0 ? PQ_INDEX_NONE : pq_pheap_pair_rounds(pq, 0);
+    
+    pq_opposite_forget(pq);
+    pq->oppositePulls = 0;
+    pq->rebuildCount += 1;
+    
+    return;
+}
@@ -0,0 +1,294 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Monotone Radix Heap storage engine (PQ_ENGINE_RADIX_HEAP)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+
+
+
+
+/*  Bucket 0 holds the keys equal to radixLast, bucket b (1 to 64) holds the keys
+    whose highest bit differing from radixLast is bit (b - 1). No key is below
+    radixLast, so every key of bucket b is below every key of bucket b + 1,
+    and a node only ever moves to a lower bucket when radixLast grows.
+*/
+#define pq_radix_key(pq, index)             ((pq)->fpPriorityKey((const void *) pq_array(pq)[(index)].priority))
+#define pq_radix_end(pq, bucket)            ((bucket) == 0 ? pq_size(pq) : (pq)->pRadixStart[(bucket) - 1])
+
+
+
+
+
+
+static unsigned int pq_radix_bucket(unsigned long long key, unsigned long long last) {
+    
+    unsigned long long diff;
+    unsigned int bucket;
+    
+    diff = key ^ last;
+    if (diff == 0)
+        return 0;
+    
+#if defined(__GNUC__)
+    bucket = 64 - (unsigned int) __builtin_clzll(diff);
+#else
+    bucket = 0;
+    while (diff != 0) {
+        diff = diff >> 1;
+        bucket += 1;
+    }
+#endif
+    
+    return bucket;
+}
+
+
+
+
+
+static void pq_radix_swap(PriorityQueue *pq, unsigned int index1, unsigned int index2) {
+    
+    PQnode node;
+    PQhandle handle;
+    
+    node = pq_array(pq)[index1];
+    handle = pq_node_handle(pq, index1);
+    pq_move_node(pq, index1, index2);
+    pq_store_node(pq, index2, &node, handle);
+    
+    return;
+}
+
+
+
+
+
+/*  Move the hole at index to the end of the array, bucket by bucket: the last
+    node of the bucket of the hole fills it, then every lower bucket gives up
+    its last node to the slot just in front of it and starts one index earlier.
+*/
+static void pq_radix_close(PriorityQueue *pq, unsigned int index) {
+    
+    unsigned int *pStart;
+    unsigned int bucket, end;
+    
+    pStart = pq->pRadixStart;
+    bucket = 0;
+    while (index < pStart[bucket])
+        bucket += 1;
+    
+    end = pq_radix_end(pq, bucket);
+    if (index != end - 1)
+        pq_move_node(pq, index, end - 1);
+    
+    while (bucket > 0) {
+        bucket -= 1;
+        end = pq_radix_end(pq, bucket);
+        if (pStart[bucket] != end)
+            pq_move_node(pq, pStart[bucket] - 1, end - 1);
+        pStart[bucket] -= 1;
+    }
+    
+    return;
+}
+
+
+
+
+
+unsigned int pq_radix_push(PriorityQueue *pq, unsigned int index) {
+    
+    PQnode node;
+    PQhandle handle;
+    unsigned int *pStart;
+    unsigned int bucket, lower, hole;
+    unsigned long long key;
+    
+    
+    key = pq_radix_key(pq, index);
+    if (key < pq->radixLast) {
+        pq_radix_fallback(pq);
+        return 0;
+    }
+    
+    
+    /* The hole starts at the end of bucket 0 and climbs to the end of the bucket */
+    /* Of the key, every lower bucket on the way shifts one slot towards the end */
+    pStart = pq->pRadixStart;
+    bucket = pq_radix_bucket(key, pq->radixLast);
+    node = pq_array(pq)[index];
+    handle = pq_node_handle(pq, index);
+    hole = index;
+    
+    for (lower = 0; lower < bucket; lower += 1) {
+        if (pStart[lower] != hole)
+            pq_move_node(pq, hole, pStart[lower]);
+        hole = pStart[lower];
+        pStart[lower] += 1;
+    }
+    pq_store_node(pq, hole, &node, handle);
+    
+    return hole;
+}
+
+
+
+
+
+unsigned int pq_radix_min_index(PriorityQueue *pq) {
+    
+    unsigned int counts[PQ_RADIX_BUCKETS];
+    unsigned int next[PQ_RADIX_BUCKETS];
+    unsigned int *pStart;
+    unsigned int bucket, lower, first, index, target;
+    unsigned long long key, minimum;
+    
+    
+    pStart = pq->pRadixStart;
+    if (pStart[0] != pq_size(pq))
+        return pq_size(pq) - 1;
+    
+    
+    /* Bucket 0 is empty, the lowest non-empty bucket holds the minimum */
+    /* It ends the array, since all the buckets below it are empty */
+    bucket = 1;
+    while (pStart[bucket] == pStart[bucket - 1])
+        bucket += 1;
+    first = pStart[bucket];
+    
+    minimum = pq_radix_key(pq, first);
+    for (index = first + 1; index < pq_size(pq); index += 1) {
+        key = pq_radix_key(pq, index);
+        if (key < minimum)
+            minimum = key;
+    }
+    pq->radixLast = minimum;
+    
+    
+    /* Every node of that bucket falls into a lower bucket relative to the new minimum */
+    /* The segment is split among them in place (counting, then cycles of swaps) */
+    for (lower = 0; lower < bucket; lower += 1)
+        counts[lower] = 0;
+    for (index = first; index < pq_size(pq); index += 1)
+        counts[pq_radix_bucket(pq_radix_key(pq, index), minimum)] += 1;
+    
+    index = first;
+    lower = bucket;
+    while (lower > 0) {
+        lower -= 1;
+        pStart[lower] = index;
+        next[lower] = index;
+        index += counts[lower];
+    }
+    
+    lower = bucket;
+    while (lower > 0) {
+        lower -= 1;
+        while (next[lower] < pq_radix_end(pq, lower)) {
+            target = pq_radix_bucket(pq_radix_key(pq, next[lower]), minimum);
+            if (target == lower) {
+                next[lower] += 1;
+            }
+            else {
+                pq_radix_swap(pq, next[lower], next[target]);
+                next[target] += 1;
+            }
+        }
+    }
+    
+    return pq_size(pq) - 1;
+}
+
+
+
+
+
+unsigned int pq_radix_max_index(PriorityQueue *pq) {
+    
+    unsigned int *pStart;
+    unsigned int bucket, index, best, end;
+    unsigned long long key, maximum;
+    
+    
+    /* The highest non-empty bucket starts the array */
+    pStart = pq->pRadixStart;
+    bucket = PQ_RADIX_BUCKETS - 1;
+    while (bucket > 0 && pStart[bucket] == pq_radix_end(pq, bucket))
+        bucket -= 1;
+    end = pq_radix_end(pq, bucket);
+    
+    best = pStart[bucket];
+    maximum = pq_radix_key(pq, best);
+    for (index = best + 1; index < end; index += 1) {
+        key = pq_radix_key(pq, index);
+        if (key > maximum) {
+            maximum = key;
+            best = index;
+        }
+    }
+    
+    return best;
+}
+
+
+
+
+
+void pq_radix_remove(PriorityQueue *pq, unsigned int index) {
+    
+    pq_radix_close(pq, index);
+    pq_size(pq) -= 1;
+    
+    return;
+}
+
+
+
+
+
+void pq_radix_relocate(PriorityQueue *pq, unsigned int index) {
+    
+    PQnode node;
+    PQhandle handle;
+    unsigned int last;
+    
+    
+    /* Take the node out, the hole it leaves goes to the end of the array */
+    /* Where the node is put back and pushed like a new one */
+    node = pq_array(pq)[index];
+    handle = pq_node_handle(pq, index);
+    pq_radix_close(pq, index);
+    
+    last = pq_size(pq) - 1;
+    pq_store_node(pq, last, &node, handle);
+    pq_radix_push(pq, last);
+    
+    return;
+}
+
+
+
+
+
+void pq_radix_fallback(PriorityQueue *pq) {
+    
+    pq_mem_free(pq, pq->pRadixStart, PQ_RADIX_BUCKETS * sizeof(unsigned int));
+    pq->pRadixStart = 0;
+    pq->heapEngine = PQ_ENGINE_BINARY_HEAP;
+    pq->heapArityShift = 1;
+    pq_bheap_orient(pq, PQ_HEAP_MIN);
+    
+    return;
+}
@@ -0,0 +1,416 @@
+
+
+/************************************************************************************
+    Implementation of Relaxed Double Ended Priority Queue ADT
+    MultiQueue over several PriorityQueue instances
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "pq.h"
+#include "pq_concurrent.h"
+#include "pq_internal.h"
+#include <stdlib.h>
+#include <stdint.h>
+#include <sched.h>
+
+
+
+
+/* One heap with its lock, padded so that no two heaps share a cache line */
+struct PQrelaxedHeap_ {
+    
+    PriorityQueue queue;
+    pthread_mutex_t lock;
+};
+
+#define PQ_RELAXED_PART_SIZE                ((sizeof(struct PQrelaxedHeap_) + PQ_CACHE_LINE_SIZE - 1) & \
+                                                ~((size_t) PQ_CACHE_LINE_SIZE - 1))
+
+union PQrelaxedPart_ {
+    
+    struct PQrelaxedHeap_ heap;
+    unsigned char padding[PQ_RELAXED_PART_SIZE];
+};
+
+/* Size of the block holding the heaps, with room for its alignment */
+#define pq_part_block_size(partCount)       ((size_t) (partCount) * sizeof(union PQrelaxedPart_) + \
+                                             PQ_CACHE_LINE_SIZE)
+
+
+
+
+/* Random state of the calling thread, seeded from its stack on first use */
+static __thread unsigned int pq_relaxed_seed;
+
+
+
+
+
+
+/* xorshift32 */
+static unsigned int pq_relaxed_random(void) {
+    
+    unsigned int x;
+    
+    
+    x = pq_relaxed_seed;
+    if (x == 0)
+        x = ((unsigned int) ((uintptr_t) &x >> 4) * 2654435761u) | 1;
+    
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    pq_relaxed_seed = x;
+    
+    return x;
+}
+
+
+
+
+
+/*  Returns nonzero if the heap pCandidate (locked, not empty) holds a better
+    extreme than the heap pBest (locked, not empty) for the given direction.
+*/
+static int pq_relaxed_better(PQrelaxed *rq, union PQrelaxedPart_ *pCandidate,
+                             union PQrelaxedPart_ *pBest, enum PQ_HeapOrient_t direction) {
+    
+    void *candidate, *best, *elem;
+    int comparison;
+    
+    
+    if (direction == PQ_HEAP_MIN) {
+        pq_peek_minimum(&pCandidate->heap.queue, &candidate, &elem);
+        pq_peek_minimum(&pBest->heap.queue, &best, &elem);
+    }
+    else {
+        pq_peek_maximum(&pCandidate->heap.queue, &candidate, &elem);
+        pq_peek_maximum(&pBest->heap.queue, &best, &elem);
+    }
+    
+    comparison = rq->fpComparePriority((const void *) candidate, (const void *) best);
+    return direction == PQ_HEAP_MIN ? comparison < 0 : comparison > 0;
+}
+
+
+
+
+
+/*  Counts the elements of all the heaps which are better than the pulled
+    priority, locking one heap at a time, and records the result.
+*/
+static void pq_relaxed_measure(PQrelaxed *rq, const void *priority, enum PQ_HeapOrient_t direction) {
+    
+    PriorityQueue *pq;
+    unsigned long long rankError, maximum;
+    unsigned int part, index;
+    int comparison;
+    
+    
+    rankError = 0;
+    for (part = 0; part < rq->partCount; part += 1) {
+        pq = &rq->pParts[part].heap.queue;
+        pthread_mutex_lock(&rq->pParts[part].heap.lock);
+        for (index = 0; index < pq_size(pq); index += 1) {
+            comparison = rq->fpComparePriority((const void *) pq_array(pq)[index].priority, priority);
+            if (direction == PQ_HEAP_MIN ? comparison < 0 : comparison > 0)
+                rankError += 1;
+        }
+        pthread_mutex_unlock(&rq->pParts[part].heap.lock);
+    }
+    
+    __atomic_add_fetch(&rq->sampleCount, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&rq->rankErrorSum, rankError, __ATOMIC_RELAXED);
+    maximum = __atomic_load_n(&rq->rankErrorMax, __ATOMIC_RELAXED);
+    while (rankError > maximum &&
+           __atomic_compare_exchange_n(&rq->rankErrorMax, &maximum, rankError, 1,
+                                       __ATOMIC_RELAXED, __ATOMIC_RELAXED) == 0)
+        ;
+    
+    return;
+}
+
+
+
+
+
+static int pq_relaxed_pull(PQrelaxed *rq, enum PQ_HeapOrient_t direction, void **priority, void **elem) {
+    
+    union PQrelaxedPart_ *pPart, *pBest;
+    unsigned long long pullCount;
+    unsigned int round, choice, start, index, interval;
+    
+    
+    pBest = 0;
+    while (pBest == 0 && __atomic_load_n(&rq->nodeCount, __ATOMIC_RELAXED) != 0) {
+    
+        /*  Lock a few random heaps which are free at the moment, and keep the
+            one with the best extreme. Only try-locks are used, so holding a
+            lock while taking the next one can not deadlock.
+        */
+        for (round = 0; round < rq->partCount && pBest == 0; round += 1) {
+            for (choice = 0; choice < rq->choiceCount; choice += 1) {
+                pPart = rq->pParts + pq_relaxed_random() % rq->partCount;
+                if (pPart == pBest || pthread_mutex_trylock(&pPart->heap.lock) != 0)
+                    continue;
+                if (pq_size(&pPart->heap.queue) == 0 ||
+                    (pBest != 0 && pq_relaxed_better(rq, pPart, pBest, direction) == 0)) {
+                    pthread_mutex_unlock(&pPart->heap.lock);
+                    continue;
+                }
+                if (pBest != 0)
+                    pthread_mutex_unlock(&pBest->heap.lock);
+                pBest = pPart;
+            }
+            if (pBest == 0)
+                sched_yield();
+        }
+    
+    
+        /* The few remaining elements are hard to hit at random, visit every heap */
+        start = pq_relaxed_random() % rq->partCount;
+        for (index = 0; index < rq->partCount && pBest == 0; index += 1) {
+            pPart = rq->pParts + (start + index) % rq->partCount;
+            pthread_mutex_lock(&pPart->heap.lock);
+            if (pq_size(&pPart->heap.queue) != 0)
+                pBest = pPart;
+            else
+                pthread_mutex_unlock(&pPart->heap.lock);
+        }
+    }
+    
+    if (pBest == 0)
+        return -1;
+    
+    
+    /* A min-max heap pulls either end without rebuilding */
+    if (direction == PQ_HEAP_MIN)
+        pq_pull_minimum(&pBest->heap.queue, priority, elem);
+    else
+        pq_pull_maximum(&pBest->heap.queue, priority, elem);
+    __atomic_sub_fetch(&rq->nodeCount, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pBest->heap.lock);
+    
+    
+    pullCount = __atomic_add_fetch(&rq->pullCount, 1, __ATOMIC_RELAXED);
+    interval = __atomic_load_n(&rq->sampleInterval, __ATOMIC_RELAXED);
+    if (interval != 0 && pullCount % interval == 0)
+        pq_relaxed_measure(rq, (const void *) *priority, direction);
+    
+    return 0;
+}
+
+
+
+
+
+int pq_relaxed_init(
+    PQrelaxed *rq,
+    unsigned int queueCount,
+    unsigned int choiceCount,
+    unsigned int capacity,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    return pq_relaxed_init_allocator(rq, queueCount, choiceCount, capacity, 0,
+                                     fpComparePriority, fpDestroyPriority, fpDestroyElement);
+}
+
+
+
+
+
+int pq_relaxed_init_allocator(
+    PQrelaxed *rq,
+    unsigned int queueCount,
+    unsigned int choiceCount,
+    unsigned int capacity,
+    const PQallocator *allocator,
+    int (*fpComparePriority) (const void *pr1, const void *pr2),
+    void (*fpDestroyPriority) (void *priority),
+    void (*fpDestroyElement) (void *element)
+)
+{
+    
+    uintptr_t address;
+    unsigned int index, partCapacity;
+    int opInit;
+    
+    
+    /* Check for invalid function arguments */
+    if (rq == 0 || queueCount == 0 || capacity == 0 || fpComparePriority == 0)
+        return -1;
+    if (allocator != 0 &&
+        (allocator->fpAlloc == 0 || allocator->fpRealloc == 0 || allocator->fpFree == 0))
+        return -1;
+    if (choiceCount == 0)
+        choiceCount = PQ_RELAXED_DEFAULT_CHOICES;
+    
+    
+    /* The heaps start on a cache line boundary */
+    rq->allocator = allocator != 0 ? *allocator : pq_default_allocator;
+    rq->pPartBlock = rq->allocator.fpAlloc(rq->allocator.context, pq_part_block_size(queueCount));
+    if (rq->pPartBlock == 0)
+        return -2;
+    address = ((uintptr_t) rq->pPartBlock + PQ_CACHE_LINE_SIZE - 1) & ~((uintptr_t) PQ_CACHE_LINE_SIZE - 1);
+    rq->pParts = (union PQrelaxedPart_ *) address;
+    
+    partCapacity = capacity / queueCount + 1;
+    for (index = 0; index < queueCount; index += 1) {
+        opInit = pq_init_allocator(&rq->pParts[index].heap.queue, PQ_ENGINE_MINMAX_HEAP, PQ_HEAP_MIN,
+                                   partCapacity, &rq->allocator,
+                                   fpComparePriority, fpDestroyPriority, fpDestroyElement);
+        if (opInit == 0 && pthread_mutex_init(&rq->pParts[index].heap.lock, 0) != 0) {
+            pq_destroy(&rq->pParts[index].heap.queue);
+            opInit = -2;
+        }
+        if (opInit != 0)
+            goto INIT_FAILED;
+    }
+    
+    rq->partCount = queueCount;
+    rq->choiceCount = choiceCount;
+    rq->nodeCount = 0;
+    rq->sampleInterval = 0;
+    rq->pullCount = 0;
+    rq->sampleCount = 0;
+    rq->rankErrorSum = 0;
+    rq->rankErrorMax = 0;
+    rq->fpComparePriority = fpComparePriority;
+    
+    return 0;
+    
+    
+    INIT_FAILED:
+    while (index > 0) {
+        index -= 1;
+        pthread_mutex_destroy(&rq->pParts[index].heap.lock);
+        pq_destroy(&rq->pParts[index].heap.queue);
+    }
+    rq->allocator.fpFree(rq->allocator.context, rq->pPartBlock, pq_part_block_size(queueCount));
+    return opInit;
+}
+
+
+
+
+
+void pq_relaxed_destroy(PQrelaxed *rq) {
+    
+    unsigned int index;
+    
+    
+    /* Check for invalid function arguments */
+    if (rq == 0)
+        return;
+    
+    for (index = 0; index < rq->partCount; index += 1) {
+        pthread_mutex_destroy(&rq->pParts[index].heap.lock);
+        pq_destroy(&rq->pParts[index].heap.queue);
+    }
+    rq->allocator.fpFree(rq->allocator.context, rq->pPartBlock, pq_part_block_size(rq->partCount));
+    
+    return;
+}
+
+
+
+
+
+int pq_relaxed_insert_with_priority(PQrelaxed *rq, const void *elem, const void *priority) {
+    
+    union PQrelaxedPart_ *pPart;
+    unsigned int attempt;
+    int result;
+    
+    
+    /* Check for invalid function arguments */
+    if (rq == 0 || elem == 0 || priority == 0)
+        return -1;
+    
+    
+    /* Any free heap will do, wait for a busy one only after many attempts */
+    for (attempt = 0; ; attempt += 1) {
+        pPart = rq->pParts + pq_relaxed_random() % rq->partCount;
+        if (attempt >= rq->partCount)
+            pthread_mutex_lock(&pPart->heap.lock);
+        else if (pthread_mutex_trylock(&pPart->heap.lock) != 0)
+            continue;
+        break;
+    }
+    
+    result = pq_insert_with_priority(&pPart->heap.queue, elem, priority);
+    if (result == 0)
+        __atomic_add_fetch(&rq->nodeCount, 1, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pPart->heap.lock);
+    
+    return result;
+}
+
+
+
+
+
+int pq_relaxed_pull_minimum(PQrelaxed *rq, void **priority, void **elem) {
+    
+    if (rq == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    return pq_relaxed_pull(rq, PQ_HEAP_MIN, priority, elem);
+}
+
+
+
+
+
+int pq_relaxed_pull_maximum(PQrelaxed *rq, void **priority, void **elem) {
+    
+    if (rq == 0 || priority == 0 || elem == 0)
+        return -1;
+    
+    return pq_relaxed_pull(rq, PQ_HEAP_MAX, priority, elem);
+}
+
+
+
+
+
+int pq_relaxed_set_rank_sampling(PQrelaxed *rq, unsigned int interval) {
+    
+    if (rq == 0)
+        return -1;
+    
+    __atomic_store_n(&rq->sampleInterval, interval, __ATOMIC_RELAXED);
+    return 0;
+}
+
+
+
+
+
+int pq_relaxed_get_stats(PQrelaxed *rq, PQrelaxedStats *stats) {
+    
+    if (rq == 0 || stats == 0)
+        return -1;
+    
+    stats->pullCount = __atomic_load_n(&rq->pullCount, __ATOMIC_RELAXED);
+    stats->sampleCount = __atomic_load_n(&rq->sampleCount, __ATOMIC_RELAXED);
+    stats->rankErrorSum = __atomic_load_n(&rq->rankErrorSum, __ATOMIC_RELAXED);
+    stats->rankErrorMax = __atomic_load_n(&rq->rankErrorMax, __ATOMIC_RELAXED);
+    
+    return 0;
+}
+
+
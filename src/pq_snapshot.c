@@ -0,0 +1,589 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Snapshots of a queue in a file, restored through a memory mapping
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "pq.h"
+#include "pq_internal.h"
+#include <stdio.h>
+#include <string.h>
+
+
+/* A snapshot is mapped where mmap() exists, and read into memory elsewhere (MinGW) */
+#if defined(__unix__) || defined(__APPLE__)
+#define PQ_SNAPSHOT_MMAP
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+
+
+#define PQ_SNAPSHOT_MAGIC                   "PQSNAP1"
+#define PQ_SNAPSHOT_BYTE_ORDER              0x01020304u
+#define PQ_SNAPSHOT_BUFFER                  256u
+#define PQ_SNAPSHOT_FILE_BUFFER             (1u << 20)
+#define pq_snapshot_align(size)             (((size) + 7) & ~(size_t) 7)
+
+
+
+
+/*  The file holds the header, then the bucket starts of a radix heap or the links
+    of a pairing heap, then a record of every node in the order of the array: the
+    size of the priority, its bytes, the size of the element and its bytes (a flat
+    object has no size). Every part starts at a multiple of 8 bytes. The numbers
+    are written in the byte order and sizes of the machine, a snapshot does not
+    move between machines.
+*/
+struct PQsnapshotHeader_ {
+    
+    char magic[8];
+    unsigned int byteOrder;
+    unsigned int engine;
+    unsigned int orientation;
+    unsigned int nodeCount;
+    unsigned int capacity;
+    unsigned int pairRoot;
+    unsigned long long radixLast;
+    unsigned long long fileSize;
+    unsigned long long priorityBytes;
+    unsigned long long elementBytes;
+    
+};
+
+
+struct PQsnapshotWriter_ {
+    
+    FILE *file;
+    unsigned long long offset;
+    unsigned char *pBuffer;
+    size_t bufferSize;
+    
+};
+
+
+
+
+
+
+static int pq_snapshot_write(struct PQsnapshotWriter_ *writer, const void *data, size_t size) {
+    
+    static const unsigned char padding[8];
+    size_t paddingSize;
+    
+    paddingSize = pq_snapshot_align(size) - size;
+    if (size != 0 && fwrite(data, 1, size, writer->file) != size)
+        return -3;
+    if (paddingSize != 0 && fwrite(padding, 1, paddingSize, writer->file) != paddingSize)
+        return -3;
+    writer->offset += size + paddingSize;
+    
+    return 0;
+}
+
+
+
+
+
+/*  Write the size and the bytes of a priority or an element, or only the bytes of
+    a flat one. The buffer of the writer grows (at least doubling) whenever an
+    object does not fit into it.
+*/
+static int pq_snapshot_write_object(
+    PriorityQueue *pq,
+    struct PQsnapshotWriter_ *writer,
+    const void *object,
+    size_t flatBytes,
+    size_t (*fpSave) (void *context, const void *object, void *buffer, size_t size),
+    void *context
+)
+{
+    
+    unsigned long long recordSize;
+    unsigned char *pBuffer;
+    size_t size, newSize;
+    
+    
+    if (flatBytes != 0)
+        return pq_snapshot_write(writer, object, flatBytes);
+    
+    size = fpSave(context, object, (void *) writer->pBuffer, writer->bufferSize);
+    if (size == (size_t) -1)
+        return -3;
+    if (size > writer->bufferSize) {
+        newSize = size > 2 * writer->bufferSize ? size : 2 * writer->bufferSize;
+        pBuffer = (unsigned char *) pq_mem_realloc(pq, (void *) writer->pBuffer,
+                                                    writer->bufferSize, newSize);
+        if (pBuffer == 0)
+            return -2;
+        writer->pBuffer = pBuffer;
+        writer->bufferSize = newSize;
+        size = fpSave(context, object, (void *) pBuffer, newSize);
+        if (size == (size_t) -1 || size > newSize)
+            return -3;
+    }
+    
+    recordSize = size;
+    if (pq_snapshot_write(writer, &recordSize, sizeof(recordSize)) != 0)
+        return -3;
+    return pq_snapshot_write(writer, writer->pBuffer, size);
+}
+
+
+
+
+
+/*  Make a private copy of the file available at *ppMap, which the flat objects can
+    be changed in: a copy-on-write mapping, or a block of the allocator of the queue.
+*/
+static int pq_snapshot_map(PriorityQueue *pq, const char *path, unsigned char **ppMap, size_t *pMapSize) {
+    
+#ifdef PQ_SNAPSHOT_MMAP
+    struct stat fileStat;
+    void *pMap;
+    int fd;
+    
+    
+    (void) pq;
+    fd = open(path, O_RDONLY);
+    if (fd < 0)
+        return -3;
+    if (fstat(fd, &fileStat) != 0 || (size_t) fileStat.st_size < sizeof(struct PQsnapshotHeader_)) {
+        close(fd);
+        return -3;
+    }
+    *pMapSize = (size_t) fileStat.st_size;
+    pMap = mmap(0, *pMapSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (pMap == MAP_FAILED)
+        return -3;
+    *ppMap = (unsigned char *) pMap;
+    
+    return 0;
+#else
+    unsigned char *pMap;
+    FILE *file;
+    long fileSize;
+    
+    
+    file = fopen(path, "rb");
+    if (file == 0)
+        return -3;
+    if (fseek(file, 0, SEEK_END) != 0 || (fileSize = ftell(file)) < (long) sizeof(struct PQsnapshotHeader_) ||
+        fseek(file, 0, SEEK_SET) != 0) {
+        fclose(file);
+        return -3;
+    }
+    pMap = (unsigned char *) pq_mem_alloc(pq, (size_t) fileSize);
+    if (pMap == 0) {
+        fclose(file);
+        return -2;
+    }
+    if (fread((void *) pMap, 1, (size_t) fileSize, file) != (size_t) fileSize) {
+        pq_mem_free(pq, (void *) pMap, (size_t) fileSize);
+        fclose(file);
+        return -3;
+    }
+    fclose(file);
+    *ppMap = pMap;
+    *pMapSize = (size_t) fileSize;
+    
+    return 0;
+#endif
+}
+
+
+
+
+
+static void pq_snapshot_unmap(PriorityQueue *pq, void *pMap, size_t mapSize) {
+    
+#ifdef PQ_SNAPSHOT_MMAP
+    (void) pq;
+    munmap(pMap, mapSize);
+#else
+    pq_mem_free(pq, pMap, mapSize);
+#endif
+    
+    return;
+}
+
+
+
+
+
+int pq_snapshot_save(PriorityQueue *pq, const char *path, const PQserializer *serializer) {
+    
+    struct PQsnapshotHeader_ header;
+    struct PQsnapshotWriter_ writer;
+    PQnode *pNode;
+    unsigned int index;
+    int result;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || path == 0 || serializer == 0)
+        return -1;
+    if ((serializer->priorityBytes == 0 && serializer->fpSavePriority == 0) ||
+        (serializer->elementBytes == 0 && serializer->fpSaveElement == 0))
+        return -1;
+    
+    memset((void *) &header, 0, sizeof(header));
+    memcpy(header.magic, PQ_SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.byteOrder = PQ_SNAPSHOT_BYTE_ORDER;
+    header.engine = (unsigned int) pq_engine(pq);
+    header.orientation = (unsigned int) pq_heap_orientation(pq);
+    header.nodeCount = pq_size(pq);
+    header.capacity = pq_capacity(pq);
+    header.pairRoot = pq->pairRoot;
+    header.radixLast = pq->radixLast;
+    header.priorityBytes = serializer->priorityBytes;
+    header.elementBytes = serializer->elementBytes;
+    
+    writer.file = fopen(path, "wb");
+    if (writer.file == 0)
+        return -3;
+    setvbuf(writer.file, 0, _IOFBF, PQ_SNAPSHOT_FILE_BUFFER);
+    writer.offset = 0;
+    writer.bufferSize = PQ_SNAPSHOT_BUFFER;
+    writer.pBuffer = (unsigned char *) pq_mem_alloc(pq, writer.bufferSize);
+    if (writer.pBuffer == 0) {
+        fclose(writer.file);
+        remove(path);
+        return -2;
+    }
+    
+    
+    /* The header is written again at the end, once the size of the file is known */
+    result = pq_snapshot_write(&writer, &header, sizeof(header));
+    if (result == 0 && pq->pRadixStart != 0)
+        result = pq_snapshot_write(&writer, pq->pRadixStart, PQ_RADIX_BUCKETS * sizeof(unsigned int));
+    if (result == 0 && pq->pPairLink != 0)
+        result = pq_snapshot_write(&writer, pq->pPairLink, pq_size(pq) * sizeof(PQpairLink));
+    
+    for (index = 0; result == 0 && index < pq_size(pq); index += 1) {
+        pNode = pq_array(pq) + index;
+        result = pq_snapshot_write_object(pq, &writer, pNode->priority, serializer->priorityBytes,
+                                          serializer->fpSavePriority, serializer->context);
+        if (result == 0)
+            result = pq_snapshot_write_object(pq, &writer, pNode->elem, serializer->elementBytes,
+                                              serializer->fpSaveElement, serializer->context);
+    }
+    
+    header.fileSize = writer.offset;
+    if (result == 0 && (fseek(writer.file, 0, SEEK_SET) != 0 ||
+                        fwrite(&header, sizeof(header), 1, writer.file) != 1))
+        result = -3;
+    if (fclose(writer.file) != 0 && result == 0)
+        result = -3;
+    
+    pq_mem_free(pq, (void *) writer.pBuffer, writer.bufferSize);
+    if (result != 0)
+        remove(path);
+    
+    return result;
+}
+
+
+
+
+
+/*  Read the record of a priority or an element at *pOffset and move past it.
+    Returns the object (a flat one stays in place), or NULL if the record is
+    damaged or cannot be loaded.
+*/
+static void *pq_snapshot_read_object(
+    const unsigned char *pMap,
+    size_t mapSize,
+    size_t *pOffset,
+    size_t flatBytes,
+    void *(*fpLoad) (void *context, const void *data, size_t size),
+    void *context
+)
+{
+    
+    unsigned long long recordSize;
+    const unsigned char *data;
+    size_t offset;
+    
+    
+    offset = *pOffset;
+    recordSize = flatBytes;
+    if (flatBytes == 0) {
+        if (mapSize - offset < sizeof(recordSize))
+            return 0;
+        memcpy(&recordSize, pMap + offset, sizeof(recordSize));
+        offset += sizeof(recordSize);
+    }
+    if (recordSize > mapSize - offset)
+        return 0;
+    
+    data = pMap + offset;
+    *pOffset = offset + pq_snapshot_align((size_t) recordSize);
+    if (*pOffset > mapSize)
+        *pOffset = mapSize;
+    
+    if (flatBytes != 0)
+        return (void *) data;
+    return fpLoad(context, (const void *) data, (size_t) recordSize);
+}
+
+
+
+
+
+/*  Destroy the objects restored so far after a failure. The flat ones belong to the mapping */
+static void pq_snapshot_discard(PriorityQueue *pq, unsigned int count, const PQserializer *serializer) {
+    
+    unsigned int index;
+    
+    for (index = 0; index < count; index += 1) {
+        if (serializer->priorityBytes == 0 && pq->fpDestroyPriority != 0)
+            pq->fpDestroyPriority(pq_array(pq)[index].priority);
+        if (serializer->elementBytes == 0 && pq->fpDestroyElement != 0)
+            pq->fpDestroyElement(pq_array(pq)[index].elem);
+    }
+    
+    return;
+}
+
+
+
+
+
+/*  The saved bucket starts of a radix heap must cover the array from bucket 64 at
+    its front down to bucket 0 at its end, never starting behind the nodes.
+*/
+static int pq_snapshot_check_radix(const struct PQsnapshotHeader_ *header, const unsigned int *pStart) {
+    
+    unsigned int bucket;
+    
+    if (pStart[0] > header->nodeCount || pStart[PQ_RADIX_BUCKETS - 1] != 0)
+        return -3;
+    for (bucket = 1; bucket < PQ_RADIX_BUCKETS; bucket += 1) {
+        if (pStart[bucket] > pStart[bucket - 1])
+            return -3;
+    }
+    
+    return 0;
+}
+
+
+
+
+
+/*  The saved links of a pairing heap must form one tree over all the nodes. The
+    tree is walked along its links (down to the first child, right to the next
+    sibling, up along prev), and every node must be reached exactly once, from
+    the node its prev names.
+*/
+static int pq_snapshot_check_pairing(const struct PQsnapshotHeader_ *header, const PQpairLink *pLink) {
+    
+    unsigned int index, next, count, nodeCount;
+    
+    
+    nodeCount = header->nodeCount;
+    if (nodeCount == 0)
+        return header->pairRoot == PQ_INDEX_NONE ? 0 : -3;
+    if (header->pairRoot >= nodeCount || pLink[header->pairRoot].prev != PQ_INDEX_NONE ||
+        pLink[header->pairRoot].sibling != PQ_INDEX_NONE)
+        return -3;
+    
+    for (index = 0; index < nodeCount; index += 1) {
+        if ((pLink[index].child >= nodeCount && pLink[index].child != PQ_INDEX_NONE) ||
+            (pLink[index].sibling >= nodeCount && pLink[index].sibling != PQ_INDEX_NONE) ||
+            (pLink[index].prev >= nodeCount && pLink[index].prev != PQ_INDEX_NONE) ||
+            (pLink[index].child != PQ_INDEX_NONE && pLink[index].child == pLink[index].sibling))
+            return -3;
+    }
+    
+    
+    count = 0;
+    index = header->pairRoot;
+    while (index != PQ_INDEX_NONE) {
+        count += 1;
+        if (count > nodeCount)
+            return -3;
+        
+        next = pLink[index].child;
+        while (next == PQ_INDEX_NONE && index != PQ_INDEX_NONE) {
+            next = pLink[index].sibling;
+            if (next != PQ_INDEX_NONE)
+                break;
+            while (pLink[index].prev != PQ_INDEX_NONE && pLink[pLink[index].prev].child != index)
+                index = pLink[index].prev;
+            index = pLink[index].prev;
+        }
+        if (next == PQ_INDEX_NONE)
+            break;
+        if (pLink[next].prev != index)
+            return -3;
+        index = next;
+    }
+    
+    return count == nodeCount ? 0 : -3;
+}
+
+
+
+
+
+int pq_snapshot_load(PriorityQueue *pq, const char *path, const PQserializer *serializer) {
+    
+    struct PQsnapshotHeader_ header;
+    unsigned char *pMap;
+    size_t mapSize, offset, radixOffset, linkOffset;
+    unsigned int index;
+    void *priority, *elem;
+    int result;
+    
+    
+    /* Check for invalid function arguments */
+    /* The flat objects live in the mapping, the queue must not destroy them */
+    if (pq == 0 || path == 0 || serializer == 0)
+        return -1;
+    if (pq_size(pq) != 0 || pq->pSnapshotMap != 0)
+        return -1;
+    if ((serializer->priorityBytes == 0 && serializer->fpLoadPriority == 0) ||
+        (serializer->elementBytes == 0 && serializer->fpLoadElement == 0) ||
+        (serializer->priorityBytes != 0 && pq->fpDestroyPriority != 0) ||
+        (serializer->elementBytes != 0 && pq->fpDestroyElement != 0))
+        return -1;
+    
+    
+    /* A private copy lets the flat objects be changed in place, the file stays as it is */
+    result = pq_snapshot_map(pq, path, &pMap, &mapSize);
+    if (result != 0)
+        return result;
+    
+    
+    /* The header must describe this file and these serializers */
+    memcpy(&header, pMap, sizeof(header));
+    radixOffset = pq_snapshot_align(sizeof(header));
+    linkOffset = radixOffset;
+    if (header.engine == PQ_ENGINE_RADIX_HEAP)
+        linkOffset += pq_snapshot_align(PQ_RADIX_BUCKETS * sizeof(unsigned int));
+    offset = linkOffset;
+    if (header.engine == PQ_ENGINE_PAIRING_HEAP)
+        offset += pq_snapshot_align((size_t) header.nodeCount * sizeof(PQpairLink));
+    
+    if (memcmp(header.magic, PQ_SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 ||
+        header.byteOrder != PQ_SNAPSHOT_BYTE_ORDER || header.fileSize != mapSize ||
+        header.nodeCount > header.capacity || header.capacity > PQ_CAPACITY_MAX ||
+        header.priorityBytes != serializer->priorityBytes ||
+        header.elementBytes != serializer->elementBytes || offset > mapSize ||
+        header.engine > (unsigned int) PQ_ENGINE_PAIRING_HEAP ||
+        (header.orientation != (unsigned int) PQ_HEAP_MIN && header.orientation != (unsigned int) PQ_HEAP_MAX)) {
+        pq_snapshot_unmap(pq, (void *) pMap, mapSize);
+        return -3;
+    }
+    
+    
+    /* The radix buckets or the pairing links are taken over by the same engine, they must hold together */
+    if (header.engine == (unsigned int) pq_engine(pq) &&
+        ((pq_engine(pq) == PQ_ENGINE_RADIX_HEAP &&
+          pq_snapshot_check_radix(&header, (const unsigned int *) (pMap + radixOffset)) != 0) ||
+         (pq_engine(pq) == PQ_ENGINE_PAIRING_HEAP &&
+          pq_snapshot_check_pairing(&header, (const PQpairLink *) (pMap + linkOffset)) != 0))) {
+        pq_snapshot_unmap(pq, (void *) pMap, mapSize);
+        return -3;
+    }
+    
+    
+    /* Grow the internal array only once, to the capacity of the saved queue */
+    if (header.capacity > pq_capacity(pq) && pq_resize_capacity(pq, header.capacity) != 0) {
+        pq_snapshot_unmap(pq, (void *) pMap, mapSize);
+        return -2;
+    }
+    
+    for (index = 0; index < header.nodeCount; index += 1) {
+        priority = pq_snapshot_read_object(pMap, mapSize, &offset, serializer->priorityBytes,
+                                           serializer->fpLoadPriority, serializer->context);
+        elem = 0;
+        if (priority != 0)
+            elem = pq_snapshot_read_object(pMap, mapSize, &offset, serializer->elementBytes,
+                                           serializer->fpLoadElement, serializer->context);
+        if (elem == 0) {
+            if (priority != 0 && serializer->priorityBytes == 0 && pq->fpDestroyPriority != 0)
+                pq->fpDestroyPriority(priority);
+            pq_snapshot_discard(pq, index, serializer);
+            pq_snapshot_unmap(pq, (void *) pMap, mapSize);
+            return -3;
+        }
+        pq_array(pq)[index].priority = priority;
+        pq_array(pq)[index].elem = elem;
+        pq_handle_acquire(pq, index, 0);
+    }
+    
+    
+    /*  The array of the same engine is restored as it was, in its orientation,
+        together with the radix buckets or the pairing links. Another engine
+        builds its own heap over the nodes, like pq_insert_batch() would.
+    */
+    if (header.engine == (unsigned int) pq_engine(pq)) {
+        pq_heap_orientation(pq) = (enum PQ_HeapOrient_t) header.orientation;
+        if (pq->pRadixStart != 0) {
+            memcpy(pq->pRadixStart, pMap + radixOffset, PQ_RADIX_BUCKETS * sizeof(unsigned int));
+            pq->radixLast = header.radixLast;
+        }
+        if (pq->pPairLink != 0) {
+            memcpy(pq->pPairLink, pMap + linkOffset, header.nodeCount * sizeof(PQpairLink));
+            pq->pairRoot = header.pairRoot;
+        }
+        pq_size(pq) = header.nodeCount;
+    }
+    else {
+        if (pq_engine(pq) == PQ_ENGINE_RADIX_HEAP) {
+            for (index = 0; index < header.nodeCount; index += 1) {
+                if (pq->fpPriorityKey(pq_array(pq)[index].priority) < pq->radixLast) {
+                    pq_radix_fallback(pq);
+                    break;
+                }
+            }
+        }
+        pq_size(pq) = header.nodeCount;
+        pq_batch_settle(pq, 0);
+    }
+    
+    
+    /* The mapping stays while flat objects of the queue live in it */
+    if ((serializer->priorityBytes != 0 || serializer->elementBytes != 0) && header.nodeCount != 0) {
+        pq->pSnapshotMap = (void *) pMap;
+        pq->snapshotMapSize = mapSize;
+    }
+    else {
+        pq_snapshot_unmap(pq, (void *) pMap, mapSize);
+    }
+    
+    return 0;
+}
+
+
+
+
+
+void pq_snapshot_release(PriorityQueue *pq) {
+    
+    if (pq->pSnapshotMap == 0)
+        return;
+    
+    pq_snapshot_unmap(pq, pq->pSnapshotMap, pq->snapshotMapSize);
+    pq->pSnapshotMap = 0;
+    pq->snapshotMapSize = 0;
+    
+    return;
+}
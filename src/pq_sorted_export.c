@@ -0,0 +1,201 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Ordered export & drain of all the elements (heapsort)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+
+
+
+
+/*  direction is 1 when the nodes are heap ordered with the largest priority on
+    top, which sorts them in ascending order, and -1 for the opposite.
+*/
+#define pq_sort_before(pq, direction, pNode1, pNode2) \
+                                            ((direction) * pq_compare_node((pq), (pNode1), (pNode2)) > 0)
+
+
+
+
+
+
+static void pq_sort_sift(PriorityQueue *pq, PQnode *pNode, unsigned int index, unsigned int size, int direction) {
+    
+    PQnode node;
+    unsigned int child;
+    
+    node = pNode[index];
+    while ((child = pq_firstchild_index(index, 1)) < size) {
+        if (child + 1 < size && pq_sort_before(pq, direction, pNode + child + 1, pNode + child))
+            child += 1;
+        if (pq_sort_before(pq, direction, pNode + child, &node) == 0)
+            break;
+        pNode[index] = pNode[child];
+        index = child;
+    }
+    pNode[index] = node;
+    
+    return;
+}
+
+
+
+
+
+/*  Heapsort of a plain PQnode array (no handles follow the nodes). isHeap is 1
+    when the array already is a binary heap in the given direction, like the
+    array of a binary heap engine, so that only the sortdown is left.
+*/
+static void pq_sort_nodes(PriorityQueue *pq, PQnode *pNode, unsigned int size, int direction, int isHeap) {
+    
+    PQnode node;
+    unsigned int index, child, parent, last;
+    
+    
+    if (size < 2)
+        return;
+    
+    if (isHeap == 0) {
+        index = size / 2;
+        while (index > 0) {
+            index -= 1;
+            pq_sort_sift(pq, pNode, index, size, direction);
+        }
+    }
+    
+    
+    /*  The top goes behind the heap. The hole it leaves walks down to a leaf along
+        the preceding children, one comparison per level, and the node which was
+        last in the heap moves up from there, which is rarely more than a level.
+    */
+    for (last = size - 1; last > 0; last -= 1) {
+        node = pNode[last];
+        pNode[last] = pNode[0];
+    
+        index = 0;
+        while ((child = pq_firstchild_index(index, 1)) < last) {
+            if (child + 1 < last && pq_sort_before(pq, direction, pNode + child + 1, pNode + child))
+                child += 1;
+            pNode[index] = pNode[child];
+            index = child;
+        }
+        while (index > 0) {
+            parent = pq_parent_index(index, 1);
+            if (pq_sort_before(pq, direction, &node, pNode + parent) == 0)
+                break;
+            pNode[index] = pNode[parent];
+            index = parent;
+        }
+        pNode[index] = node;
+    }
+    
+    return;
+}
+
+
+
+
+
+/*  Sort the nodes and hand them out in the requested order. A binary heap engine
+    is sorted in its own orientation, which skips building the heap.
+*/
+static void pq_sort_out(
+    PriorityQueue *pq,
+    PQnode *pNode,
+    int ascending,
+    void **priorities,
+    void **elems
+)
+{
+    
+    unsigned int index, size, target;
+    int direction, isHeap;
+    
+    
+    size = pq_size(pq);
+    isHeap = pq_engine(pq) == PQ_ENGINE_BINARY_HEAP ? 1 : 0;
+    direction = isHeap == 1 && pq_heap_orientation(pq) == PQ_HEAP_MIN ? -1 : 1;
+    pq_sort_nodes(pq, pNode, size, direction, isHeap);
+    
+    /* The sorted nodes are ascending when direction is 1 */
+    for (index = 0; index < size; index += 1) {
+        target = (direction == 1) == (ascending != 0) ? index : size - 1 - index;
+        priorities[target] = pNode[index].priority;
+        elems[target] = pNode[index].elem;
+    }
+    
+    return;
+}
+
+
+
+
+
+void pq_sort_array(PriorityQueue *pq) {
+    
+    pq_sort_nodes(pq, pq_array(pq), pq_size(pq), 1, 0);
+    
+    return;
+}
+
+
+
+
+
+int pq_export_sorted(PriorityQueue *pq, int ascending, void **priorities, void **elems) {
+    
+    PQnode *pScratch;
+    size_t scratchSize;
+    unsigned int index;
+    
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priorities == 0 || elems == 0)
+        return -1;
+    if (pq_size(pq) == 0)
+        return 0;
+    
+    
+    /* The live array is never touched, a copy of it is sorted */
+    scratchSize = (size_t) pq_size(pq) * sizeof(PQnode);
+    pScratch = (PQnode *) pq_mem_alloc(pq, scratchSize);
+    if (pScratch == 0)
+        return -2;
+    for (index = 0; index < pq_size(pq); index += 1)
+        pScratch[index] = pq_array(pq)[index];
+    
+    pq_sort_out(pq, pScratch, ascending, priorities, elems);
+    
+    pq_mem_free(pq, (void *) pScratch, scratchSize);
+    return 0;
+}
+
+
+
+
+
+int pq_drain_sorted(PriorityQueue *pq, int ascending, void **priorities, void **elems) {
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || priorities == 0 || elems == 0)
+        return -1;
+    
+    
+    /* The nodes are sorted in place, the handles stay behind with the slots */
+    /* And are all released once the sorted nodes have been handed out */
+    pq_sort_out(pq, pq_array(pq), ascending, priorities, elems);
+    pq_release_all(pq);
+    
+    return 0;
+}
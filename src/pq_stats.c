@@ -0,0 +1,59 @@
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT
+    Work counters of the hot paths (compiled in with PQ_ENABLE_STATS)
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+#include <string.h>
+
+
+
+
+int pq_stats_get(const PriorityQueue *pq, PQstats *stats) {
+    
+    /* Check for invalid function arguments */
+    if (pq == 0 || stats == 0)
+        return -1;
+    
+    *stats = pq->stats;
+    
+    /* Re-orientations and leaf scans are always counted by the queue itself */
+    stats->rebuilds = pq->rebuildCount;
+    stats->leafScans = pq->leafScanCount;
+    
+#ifdef PQ_ENABLE_STATS
+    return 0;
+#else
+    return -3;
+#endif
+}
+
+
+
+
+
+int pq_stats_reset(PriorityQueue *pq) {
+    
+    /* Check for invalid function arguments */
+    if (pq == 0)
+        return -1;
+    
+    memset((void *) &pq->stats, 0, sizeof(PQstats));
+    pq->rebuildCount = 0;
+    pq->leafScanCount = 0;
+    
+    return 0;
+}
+
+
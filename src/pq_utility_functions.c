@@ -1,86 +1,370 @@
-
-
-/************************************************************************************
-    Implementation of Double Ended Priority Queue ADT Utility functions
-    Author:             Ashis Kumar Das
-    Email:              akd.bracu@gmail.com
-    GitHub:             https://github.com/AKD92
-*************************************************************************************/
-
-
-
-
-
-
-
-#include "pq.h"
-#include "pq_internal.h"
-#include <string.h>
-#include <stdlib.h>
-
-
-
-
-
-
-
-
-
-int pq_expand_capacity(PriorityQueue *pq) {
-    
-    void *array_new, *array_old;
-    unsigned int new_capacity, old_capacity;
-    
-    
-    if (pq == 0)
-        return -2;
-    
-    
-    /* Calculate the size (not in bytes) of new expanded memory region */
-    /* New size is the size of old memory region multiplied by Expand Factor */
-    old_capacity = pq_capacity(pq);
-    new_capacity = old_capacity * PQ_DEFAULT_EXPANSION_FACTOR;
-    
-    
-    /* Request for an expanded memory region using malloc() */
-    array_old = (void *) pq_array(pq);
-    array_new = (void *) malloc(new_capacity * sizeof(PQnode));
-    
-    
-    /* If the request for allocating new memory region */
-    /* Is not granted, return -2 to signal this problem */
-    if (array_new == 0)
-        return -1;
-    
-    
-    /* Copy data from old memory region to new expanded memory region */
-    memcpy((void *) array_new, (const void *) array_old, old_capacity * sizeof(PQnode));
-    
-    
-    /* Adjust this Priority Queue to use new memory region */
-    pq_array(pq) = (PQnode *) array_new;
-    pq_capacity(pq) = new_capacity;
-    
-    
-    /* Release old memory region */
-    free((void*) array_old);
-    
-    return 0;
-}
-
-
-
-
-int pq_compare_node(const void *arg1, const void *arg2) {
-    
-    int iCompareVal;
-    PQnode *pNode1, *pNode2;
-    
-    pNode1 = (PQnode *) arg1;
-    pNode2 = (PQnode *) arg2;
-    
-    iCompareVal = pNode1->fpComparePriority((const void *) pNode1->priority, (const void *) pNode2->priority);
-    return iCompareVal;
-}
-
-
+
+
+/************************************************************************************
+    Implementation of Double Ended Priority Queue ADT Utility functions
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+
+
+
+
+#include "pq.h"
+#include "pq_internal.h"
+#include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+
+
+
+
+
+
+
+
+int pq_expand_capacity(PriorityQueue *pq) {
+    
+    unsigned int new_capacity;
+    
+    
+    if (pq == 0)
+        return -2;
+    
+    
+    /* New size is the size of old memory region multiplied by the growth percent */
+    new_capacity = pq_next_capacity(pq, pq_capacity(pq), (size_t) pq_capacity(pq) + 1);
+    if (new_capacity == 0)
+        return -1;
+    
+    return pq_resize_capacity(pq, new_capacity);
+}
+
+
+
+
+
+unsigned int pq_next_capacity(const PriorityQueue *pq, unsigned int capacity, size_t needed) {
+    
+    size_t grown, next;
+    
+    
+    if (needed > PQ_CAPACITY_MAX)
+        return 0;
+    
+    
+    /* Grow by at least one slot at a time, so that small arrays grow too */
+    grown = capacity == 0 ? 1 : capacity;
+    while (grown < needed) {
+        next = grown / 100 * pq->growthPercent + grown % 100 * pq->growthPercent / 100;
+        grown = next > grown ? next : grown + 1;
+        if (grown > PQ_CAPACITY_MAX)
+            return PQ_CAPACITY_MAX;
+    }
+    
+    return (unsigned int) grown;
+}
+
+
+
+
+
+void pq_shrink_capacity(PriorityQueue *pq) {
+    
+    size_t new_capacity;
+    
+    
+    /* Leave room to grow by the growth percent, like right after a growth */
+    new_capacity = (size_t) pq_size(pq) / 100 * pq->growthPercent +
+                    (size_t) pq_size(pq) % 100 * pq->growthPercent / 100;
+    if (new_capacity < pq->minCapacity)
+        new_capacity = pq->minCapacity;
+    if (new_capacity >= pq_capacity(pq)) {
+        pq->shrinkBelow = 0;
+        return;
+    }
+    
+    /* Without memory to move into, the old array stays until the next growth */
+    if (pq_resize_capacity(pq, (unsigned int) new_capacity) != 0)
+        pq->shrinkBelow = 0;
+    
+    return;
+}
+
+
+
+
+
+void pq_release_all(PriorityQueue *pq) {
+    
+    unsigned int index, bucket;
+    
+    
+    for (index = 0; index < pq_size(pq); index += 1)
+        pq_handle_release(pq, index);
+    pq_size(pq) = 0;
+    
+    pq_opposite_forget(pq);
+    pq->oppositePulls = 0;
+    pq->pairRoot = PQ_INDEX_NONE;
+    if (pq->pRadixStart != 0) {
+        for (bucket = 0; bucket < PQ_RADIX_BUCKETS; bucket += 1)
+            pq->pRadixStart[bucket] = 0;
+    }
+    
+    if (pq_should_shrink(pq))
+        pq_shrink_capacity(pq);
+    
+    return;
+}
+
+
+
+
+
+size_t pq_node_block_size(const PriorityQueue *pq, unsigned int capacity) {
+    
+    unsigned int padding;
+    
+    
+    /* Room for the padding slots and for the alignment itself */
+    padding = pq_node_padding(pq);
+    if (padding == 0)
+        return (size_t) capacity * sizeof(PQnode);
+    
+    return ((size_t) capacity + padding) * sizeof(PQnode) + PQ_CACHE_LINE_SIZE;
+}
+
+
+
+
+
+/*  Locate the PQnode array inside its memory block */
+static PQnode *pq_node_array_place(const PriorityQueue *pq, void *pBlock) {
+    
+    uintptr_t address;
+    unsigned int padding;
+    
+    
+    /* Plain engines use the memory block as it is */
+    padding = pq_node_padding(pq);
+    if (padding == 0)
+        return (PQnode *) pBlock;
+    
+    address = ((uintptr_t) pBlock + PQ_CACHE_LINE_SIZE - 1) & ~((uintptr_t) PQ_CACHE_LINE_SIZE - 1);
+    return (PQnode *) address + padding;
+}
+
+
+
+
+
+PQnode *pq_node_array_alloc(const PriorityQueue *pq, unsigned int capacity, void **ppBlock) {
+    
+    void *pBlock;
+    
+    
+    pBlock = pq_mem_alloc(pq, pq_node_block_size(pq, capacity));
+    *ppBlock = pBlock;
+    if (pBlock == 0)
+        return 0;
+    
+    return pq_node_array_place(pq, pBlock);
+}
+
+
+
+
+
+/* Number of entries a resize of the parallel arrays keeps */
+#define pq_parallel_kept(from, to)          ((to) < (from) ? (to) : (from))
+
+
+
+
+
+/*  Resize the arrays which are parallel to the nodes (position map, pairing heap
+    links) to the given capacity. Each array remembers its own length, since an
+    array which can not be resized keeps its old size: a failed growth or shrink
+    leaves it larger than the nodes, which is harmless, and the allocator is still
+    told the true size of the block on the next realloc or free.
+*/
+static int pq_resize_parallel(PriorityQueue *pq, unsigned int to_capacity) {
+    
+    unsigned int *handles_new;
+    PQpairLink *links_new;
+    
+    
+    if (pq->pNodeHandle != 0 && pq->nodeHandleCapacity != to_capacity) {
+        handles_new = (unsigned int *) pq_mem_realloc(pq, (void *) pq->pNodeHandle,
+                                pq->nodeHandleCapacity * sizeof(unsigned int),
+                                to_capacity * sizeof(unsigned int));
+        if (handles_new == 0)
+            return -1;
+        if (handles_new != pq->pNodeHandle)
+            pq_stats_add(pq, bytesCopied, pq_parallel_kept(pq->nodeHandleCapacity, to_capacity) *
+                                          sizeof(unsigned int));
+        pq->pNodeHandle = handles_new;
+        pq->nodeHandleCapacity = to_capacity;
+    }
+    
+    if (pq->pPairLink != 0 && pq->pairLinkCapacity != to_capacity) {
+        links_new = (PQpairLink *) pq_mem_realloc(pq, (void *) pq->pPairLink,
+                                pq->pairLinkCapacity * sizeof(PQpairLink),
+                                to_capacity * sizeof(PQpairLink));
+        if (links_new == 0)
+            return -1;
+        if (links_new != pq->pPairLink)
+            pq_stats_add(pq, bytesCopied, pq_parallel_kept(pq->pairLinkCapacity, to_capacity) *
+                                          sizeof(PQpairLink));
+        pq->pPairLink = links_new;
+        pq->pairLinkCapacity = to_capacity;
+    }
+    
+    return 0;
+}
+
+
+
+
+
+int pq_resize_capacity(PriorityQueue *pq, unsigned int new_capacity) {
+    
+    PQnode *array_new;
+    void *block_new;
+    unsigned int old_capacity;
+    size_t old_offset;
+    
+    
+    if (pq == 0)
+        return -2;
+    
+    old_capacity = pq_capacity(pq);
+    if (new_capacity < pq_size(pq))
+        new_capacity = pq_size(pq);
+    if (new_capacity == 0)
+        new_capacity = 1;
+    if (new_capacity == old_capacity)
+        return 0;
+    
+    
+    /* The position map & the links (if any) grow before the nodes and shrink after them, */
+    /* so that they are never shorter than the array of nodes, whatever fails */
+    if (new_capacity > old_capacity && pq_resize_parallel(pq, new_capacity) != 0)
+        return -1;
+    
+    
+    /* Request for a resized memory region from the allocator, */
+    /* which may resize the old region in place instead of copying it */
+    old_offset = (size_t) ((unsigned char *) pq_array(pq) - (unsigned char *) pq->pArrayBlock);
+    block_new = pq_mem_realloc(pq, pq->pArrayBlock, pq_node_block_size(pq, old_capacity),
+                                pq_node_block_size(pq, new_capacity));
+    if (block_new == 0)
+        return -1;
+    
+    
+    /* A moved block may be aligned differently, then the nodes follow the alignment */
+    array_new = pq_node_array_place(pq, block_new);
+    if ((unsigned char *) array_new != (unsigned char *) block_new + old_offset) {
+        memmove((void *) array_new, (const void *) ((unsigned char *) block_new + old_offset),
+                    pq_size(pq) * sizeof(PQnode));
+        pq_stats_add(pq, bytesCopied, pq_size(pq) * sizeof(PQnode));
+    }
+    
+    
+    /* A block which had to move was copied as a whole by the allocator */
+    if (block_new != pq->pArrayBlock)
+        pq_stats_add(pq, bytesCopied, pq_node_block_size(pq, new_capacity < old_capacity ?
+                                                              new_capacity : old_capacity));
+    if (new_capacity > old_capacity)
+        pq_stats_add(pq, expansions, 1);
+    else
+        pq_stats_add(pq, shrinks, 1);
+    
+    
+    /* Adjust this Priority Queue to use new memory region */
+    /* The next shrink is due when the new array gets too empty */
+    pq_array(pq) = array_new;
+    pq->pArrayBlock = block_new;
+    pq_capacity(pq) = new_capacity;
+    pq->shrinkBelow = new_capacity <= pq->minCapacity ? 0 :
+                        (unsigned int) ((size_t) new_capacity * pq->shrinkPercent / 100);
+    
+    if (new_capacity < old_capacity)
+        pq_resize_parallel(pq, new_capacity);
+    
+    return 0;
+}
+
+
+
+
+
+unsigned int pq_log2(unsigned int value) {
+    
+    unsigned int result;
+    
+    result = 0;
+    while (value > 1) {
+        value = value >> 1;
+        result += 1;
+    }
+    
+    return result;
+}
+
+
+
+
+int pq_compare_node(PriorityQueue *pq, const PQnode *pNode1, const PQnode *pNode2) {
+    
+    int iCompareVal;
+    
+    iCompareVal = pq_compare_priority(pq, pNode1->priority, pNode2->priority);
+    return iCompareVal;
+}
+
+
+
+
+
+void pq_store_node(PriorityQueue *pq, unsigned int index, const PQnode *pNode, PQhandle handle) {
+    
+    pq_array(pq)[index] = *pNode;
+    
+    
+    /* Keep the position map in sync with the nodes */
+    if (pq->pNodeHandle != 0) {
+        pq->pNodeHandle[index] = handle;
+        if (handle != PQ_HANDLE_NONE)
+            pq->pHandleIndex[handle] = index;
+    }
+    
+    return;
+}
+
+
+
+
+
+void pq_move_node(PriorityQueue *pq, unsigned int dst, unsigned int src) {
+    
+    pq_array(pq)[dst] = pq_array(pq)[src];
+    pq_stats_add(pq, nodeMoves, 1);
+    
+    
+    /* Keep the position map in sync with the nodes */
+    if (pq->pNodeHandle != 0) {
+        pq->pNodeHandle[dst] = pq->pNodeHandle[src];
+        if (pq->pNodeHandle[dst] != PQ_HANDLE_NONE)
+            pq->pHandleIndex[pq->pNodeHandle[dst]] = dst;
+    }
+    
+    return;
+}
+
+
@@ -0,0 +1,218 @@
+
+
+/************************************************************************************
+    Tests of C++ Double Ended Priority Queue ADT
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+/*
+ *  pq::double_ended_queue is checked against a std::multimap through random
+ *  inserts and pulls from both ends, then with move-only values, in place
+ *  construction, range loading, a reversed comparator and a custom allocator.
+ *
+ *  Build (or use the CMake target pq_hpp_test):
+ *      g++ -std=c++11 -Iinclude tests/pq_hpp_test.cpp -o pq_hpp_test
+*/
+
+
+
+
+#include "pq.hpp"
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <tuple>
+
+
+
+
+#define PQ_CHECK(condition)                 pq_test_check((condition), #condition, __FILE__, __LINE__)
+
+
+static unsigned int failures;
+static unsigned int randomState = 12345u;
+
+
+
+
+static bool pq_test_check(bool passed, const char *condition, const char *file, int line) {
+    
+    if (passed == false) {
+        std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+        failures += 1;
+    }
+    return passed;
+}
+
+
+static unsigned int pq_test_random() {
+    
+    randomState = randomState * 1103515245u + 12345u;
+    return randomState >> 8;
+}
+
+
+
+
+static void test_against_multimap() {
+    
+    pq::double_ended_queue<int, int> queue;
+    std::multimap<int, int> reference;
+    std::pair<int, int> pulled;
+    int key;
+    
+    for (int step = 0; step < 200000; step += 1) {
+        switch (pq_test_random() % 5) {
+        case 0:
+        case 1:
+            key = (int) (pq_test_random() % 1000);
+            queue.insert(key, step);
+            reference.insert(std::make_pair(key, step));
+            break;
+        case 2:
+            if (queue.empty())
+                break;
+            pulled = queue.pull_minimum();
+            PQ_CHECK(pulled.first == reference.begin()->first);
+            reference.erase(reference.begin());
+            break;
+        case 3:
+            if (queue.empty())
+                break;
+            pulled = queue.pull_maximum();
+            PQ_CHECK(pulled.first == reference.rbegin()->first);
+            reference.erase(std::prev(reference.end()));
+            break;
+        default:
+            if (queue.empty())
+                break;
+            PQ_CHECK(queue.peek_minimum().first == reference.begin()->first);
+            PQ_CHECK(queue.peek_maximum().first == reference.rbegin()->first);
+            break;
+        }
+        PQ_CHECK(queue.size() == reference.size());
+    }
+}
+
+
+static void test_move_only() {
+    
+    pq::double_ended_queue<std::unique_ptr<int>, std::unique_ptr<std::string>,
+                           bool (*) (const std::unique_ptr<int> &, const std::unique_ptr<int> &)>
+        queue([] (const std::unique_ptr<int> &a, const std::unique_ptr<int> &b) { return *a < *b; });
+    
+    for (int index = 0; index < 1000; index += 1) {
+        int key = (int) (pq_test_random() % 100);
+        queue.emplace(std::unique_ptr<int>(new int(key)),
+                      std::unique_ptr<std::string>(new std::string(std::to_string(key))));
+    }
+    
+    int low = -1, high = 100;
+    while (queue.empty() == false) {
+        auto minimum = queue.pull_minimum();
+        PQ_CHECK(*minimum.first >= low && *minimum.second == std::to_string(*minimum.first));
+        low = *minimum.first;
+        if (queue.empty())
+            break;
+        auto maximum = queue.pull_maximum();
+        PQ_CHECK(*maximum.first <= high && *maximum.first >= low);
+        high = *maximum.first;
+    }
+}
+
+
+static void test_emplace_and_range() {
+    
+    std::vector<std::pair<int, std::string> > pairs;
+    for (int index = 0; index < 500; index += 1)
+        pairs.push_back(std::make_pair((int) (pq_test_random() % 50), std::string(3, 'a' + index % 26)));
+    
+    /* Under std::greater the minimum end holds the largest key */
+    pq::double_ended_queue<int, std::string, std::greater<int> > queue(pairs.begin(), pairs.end());
+    queue.emplace(std::piecewise_construct, std::forward_as_tuple(100), std::forward_as_tuple(5, 'z'));
+    PQ_CHECK(queue.size() == 501);
+    PQ_CHECK(queue.peek_minimum().first == 100 && queue.peek_minimum().second == "zzzzz");
+    
+    int previous = 100;
+    while (queue.empty() == false) {
+        int key = queue.pull_minimum().first;
+        PQ_CHECK(key <= previous);
+        previous = key;
+    }
+}
+
+
+
+
+/* Counts the live allocations, to check that the elements need none of their own */
+template <class T>
+struct counting_allocator {
+    
+    typedef T value_type;
+    
+    static int live;
+    
+    counting_allocator() {}
+    template <class U> counting_allocator(const counting_allocator<U> &) {}
+    
+    T *allocate(std::size_t count) {
+        live += 1;
+        return std::allocator<T>().allocate(count);
+    }
+    void deallocate(T *block, std::size_t count) {
+        live -= 1;
+        std::allocator<T>().deallocate(block, count);
+    }
+    
+    template <class U> bool operator==(const counting_allocator<U> &) const { return true; }
+    template <class U> bool operator!=(const counting_allocator<U> &) const { return false; }
+};
+
+template <class T> int counting_allocator<T>::live = 0;
+
+
+typedef counting_allocator<std::pair<double, int> > pair_allocator;
+
+
+static void test_allocator() {
+    {
+        pq::double_ended_queue<double, int, std::less<double>, pair_allocator> queue, other;
+    
+        queue.reserve(1000);
+        for (int index = 0; index < 1000; index += 1)
+            queue.insert((double) (pq_test_random() % 1000) / 8, index);
+        PQ_CHECK(pair_allocator::live == 1);
+    
+        swap(queue, other);
+        PQ_CHECK(queue.empty() && other.size() == 1000);
+        other.clear();
+        other.shrink_to_fit();
+    }
+    PQ_CHECK(pair_allocator::live == 0);
+}
+
+
+
+
+int main() {
+    
+    test_against_multimap();
+    test_move_only();
+    test_emplace_and_range();
+    test_allocator();
+    
+    if (failures != 0) {
+        std::fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    std::printf("all tests passed\n");
+    return 0;
+}
+
+
@@ -0,0 +1,1097 @@
+
+
+/************************************************************************************
+    Tests of Double Ended Priority Queue ADT
+    Author:             Ashis Kumar Das
+    Email:              akd.bracu@gmail.com
+    GitHub:             https://github.com/AKD92
+*************************************************************************************/
+
+
+
+/*
+ *  Every storage engine is checked against a sorted copy of the keys, through
+ *  all the pull, peek, handle, batch, merge, sorted export, snapshot and
+ *  capacity operations, followed by the allocator, the typed queues, the
+ *  thread safe front ends and the external memory queue.
+ *  The program prints every failed check and exits with 1 if there was any.
+ *
+ *  Build (or use the CMake target pq_test):
+ *      gcc -std=c99 -Iinclude src/pq_*.c tests/pq_test.c -o pq_test -pthread
+*/
+
+
+
+
+#include "pq.h"
+#include "pq_concurrent.h"
+#include "pq_external.h"
+#include "pq_typed.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+
+
+#define PQ_TEST_COUNT                       2000
+#define PQ_TEST_THREADS                     4
+
+#define PQ_CHECK(condition)                 pq_test_check((condition) != 0, #condition, __FILE__, __LINE__)
+
+
+static const struct {
+    enum PQ_Engine_t engine;
+    const char *name;
+} testEngines[] = {
+    { PQ_ENGINE_BINARY_HEAP, "binary" },
+    { PQ_ENGINE_MINMAX_HEAP, "minmax" },
+    { PQ_ENGINE_DARY4_HEAP, "dary4" },
+    { PQ_ENGINE_DARY8_HEAP, "dary8" },
+    { PQ_ENGINE_RADIX_HEAP, "radix" },
+    { PQ_ENGINE_PAIRING_HEAP, "pairing" }
+};
+
+#define PQ_TEST_ENGINE_COUNT                (sizeof(testEngines) / sizeof(testEngines[0]))
+
+
+static unsigned int failures;
+static const char *currentTest;
+static int keys[PQ_TEST_COUNT];
+static int sortedKeys[PQ_TEST_COUNT];
+static unsigned int randomState = 12345u;
+
+
+
+
+static int pq_test_check(int passed, const char *condition, const char *file, int line) {
+    
+    if (passed == 0) {
+        fprintf(stderr, "%s:%d: [%s] check failed: %s\n", file, line, currentTest, condition);
+        failures += 1;
+    }
+    return passed;
+}
+
+
+static unsigned int pq_test_random(void) {
+    
+    randomState = randomState * 1103515245u + 12345u;
+    return randomState >> 8;
+}
+
+
+static int compare_int(const void *p1, const void *p2) {
+    
+    int a = *(const int *) p1;
+    int b = *(const int *) p2;
+    
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+
+/* Radix heap key of an int, in the same order (the sign bit is flipped) */
+static unsigned long long key_int(const void *p) {
+    
+    return (unsigned long long) (long long) *(const int *) p ^ 0x8000000000000000ull;
+}
+
+
+/* The radix heap engine is initialized by its own function, which needs the key */
+static int pq_test_init(PriorityQueue *pq, enum PQ_Engine_t engine, enum PQ_HeapOrient_t hOrientation,
+                        unsigned int capacity) {
+    
+    if (engine == PQ_ENGINE_RADIX_HEAP)
+        return pq_init_radix(pq, capacity, 0, key_int, compare_int, 0, 0);
+    return pq_init_engine(pq, engine, hOrientation, capacity, compare_int, 0, 0);
+}
+
+
+static size_t save_int(void *context, const void *object, void *buffer, size_t size) {
+    
+    (void) context;
+    if (size >= sizeof(int))
+        memcpy(buffer, object, sizeof(int));
+    return sizeof(int);
+}
+
+
+static void *load_int(void *context, const void *data, size_t size) {
+    
+    int *object;
+    
+    (void) context;
+    if (size != sizeof(int) || (object = (int *) malloc(sizeof(int))) == 0)
+        return 0;
+    memcpy(object, data, sizeof(int));
+    return object;
+}
+
+
+/* The keys are drawn from a small range, so that there are many duplicates */
+static void pq_test_make_keys(void) {
+    
+    unsigned int index;
+    
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        keys[index] = (int) (pq_test_random() % (PQ_TEST_COUNT / 2));
+    memcpy(sortedKeys, keys, sizeof(keys));
+    qsort(sortedKeys, PQ_TEST_COUNT, sizeof(int), compare_int);
+}
+
+
+static int pq_test_fill(PriorityQueue *pq, enum PQ_Engine_t engine, enum PQ_HeapOrient_t hOrientation) {
+    
+    unsigned int index;
+    
+    if (PQ_CHECK(pq_test_init(pq, engine, hOrientation, 4) == 0) == 0)
+        return -1;
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_insert_with_priority(pq, &keys[index], &keys[index]) == 0);
+    PQ_CHECK(pq_size(pq) == PQ_TEST_COUNT);
+    
+    return 0;
+}
+
+
+
+
+/* Pulls from both ends in changing runs, which covers the lazy re-orientation */
+static void test_pull_both_ends(enum PQ_Engine_t engine, enum PQ_HeapOrient_t hOrientation) {
+    
+    PriorityQueue pq;
+    void *priority, *elem;
+    unsigned int low, high, run;
+    int fromMin;
+    
+    if (pq_test_fill(&pq, engine, hOrientation) != 0)
+        return;
+    
+    low = 0;
+    high = PQ_TEST_COUNT;
+    fromMin = 1;
+    while (low < high) {
+        for (run = 1 + pq_test_random() % 6; run > 0 && low < high; run -= 1) {
+            if (fromMin != 0) {
+                PQ_CHECK(pq_peek_maximum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[high - 1]);
+                PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[low]);
+                low += 1;
+            }
+            else {
+                PQ_CHECK(pq_peek_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[low]);
+                PQ_CHECK(pq_pull_maximum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[high - 1]);
+                high -= 1;
+            }
+            PQ_CHECK(priority == elem);
+        }
+        fromMin = !fromMin;
+    }
+    
+    PQ_CHECK(pq_size(&pq) == 0);
+    PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) != 0);
+    PQ_CHECK(pq_peek_maximum(&pq, &priority, &elem) != 0);
+    pq_destroy(&pq);
+}
+
+
+/* Peeks & single pulls from the opposite end leave the heap as it is, */
+/* only the fourth pull in a row from there re-orients it */
+static void test_opposite_end(enum PQ_Engine_t engine) {
+    
+    PriorityQueue pq;
+    void *priority, *elem;
+    unsigned int pulls;
+    int rebuilds;
+    
+    if (pq_test_fill(&pq, engine, PQ_HEAP_MIN) != 0)
+        return;
+    
+    /* Only the binary, d-ary & pairing heaps are ever rebuilt */
+    rebuilds = engine == PQ_ENGINE_BINARY_HEAP || engine == PQ_ENGINE_DARY4_HEAP ||
+                engine == PQ_ENGINE_DARY8_HEAP || engine == PQ_ENGINE_PAIRING_HEAP;
+    
+    PQ_CHECK(pq_peek_maximum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[PQ_TEST_COUNT - 1]);
+    for (pulls = 1; pulls <= 3; pulls += 1) {
+        PQ_CHECK(pq_pull_maximum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[PQ_TEST_COUNT - pulls]);
+        PQ_CHECK(pq_peek_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[0]);
+    }
+    PQ_CHECK(pq_rebuild_count(&pq) == 0);
+    PQ_CHECK(rebuilds == 0 || pq_leaf_scan_count(&pq) > 0);
+    
+    PQ_CHECK(pq_pull_maximum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[PQ_TEST_COUNT - 4]);
+    PQ_CHECK(pq_rebuild_count(&pq) == (rebuilds != 0 ? 1u : 0u));
+    PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[0]);
+    pq_destroy(&pq);
+}
+
+
+static void test_k_operations(enum PQ_Engine_t engine, enum PQ_HeapOrient_t hOrientation) {
+    
+    PriorityQueue pq;
+    void *priorities[64], *elems[64];
+    unsigned int low, high, index;
+    int count;
+    
+    if (pq_test_fill(&pq, engine, hOrientation) != 0)
+        return;
+    
+    count = pq_peek_min_k(&pq, 64, priorities, elems);
+    PQ_CHECK(count == 64);
+    for (index = 0; index < (unsigned int) count; index += 1)
+        PQ_CHECK(*(int *) priorities[index] == sortedKeys[index]);
+    count = pq_peek_max_k(&pq, 64, priorities, elems);
+    PQ_CHECK(count == 64);
+    for (index = 0; index < (unsigned int) count; index += 1)
+        PQ_CHECK(*(int *) priorities[index] == sortedKeys[PQ_TEST_COUNT - 1 - index]);
+    PQ_CHECK(pq_size(&pq) == PQ_TEST_COUNT);
+    
+    low = 0;
+    high = PQ_TEST_COUNT;
+    while (low < high) {
+        count = pq_pull_min_k(&pq, 1 + pq_test_random() % 16, priorities, elems);
+        PQ_CHECK(count > 0);
+        for (index = 0; index < (unsigned int) count; index += 1, low += 1)
+            PQ_CHECK(*(int *) priorities[index] == sortedKeys[low]);
+        count = pq_pull_max_k(&pq, 1 + pq_test_random() % 16, priorities, elems);
+        for (index = 0; index < (unsigned int) count; index += 1, high -= 1)
+            PQ_CHECK(*(int *) priorities[index] == sortedKeys[high - 1]);
+    }
+    
+    PQ_CHECK(low == high && pq_size(&pq) == 0);
+    PQ_CHECK(pq_pull_min_k(&pq, 4, priorities, elems) == 0);
+    pq_destroy(&pq);
+}
+
+
+/* Every element gets a handle, then half of them are changed and a quarter removed */
+static void test_handles(enum PQ_Engine_t engine, enum PQ_HeapOrient_t hOrientation) {
+    
+    static PQhandle handles[PQ_TEST_COUNT];
+    static int priorities[PQ_TEST_COUNT];
+    static int expected[PQ_TEST_COUNT];
+    PriorityQueue pq;
+    void *priority, *elem, *oldPriority;
+    unsigned int index, count;
+    
+    if (PQ_CHECK(pq_test_init(&pq, engine, hOrientation, 4) == 0) == 0)
+        return;
+    
+    for (index = 0; index < PQ_TEST_COUNT; index += 1) {
+        priorities[index] = keys[index];
+        PQ_CHECK(pq_insert_with_handle(&pq, &keys[index], &priorities[index], &handles[index]) == 0);
+    }
+    
+    count = 0;
+    for (index = 0; index < PQ_TEST_COUNT; index += 1) {
+        switch (index % 4) {
+        case 0:
+            PQ_CHECK(pq_remove(&pq, handles[index], &priority, &elem) == 0 && elem == &keys[index]);
+            PQ_CHECK(pq_remove(&pq, handles[index], &priority, &elem) == -2);
+            continue;
+        case 1:
+            priorities[index] = (int) (pq_test_random() % PQ_TEST_COUNT) - PQ_TEST_COUNT / 2;
+            PQ_CHECK(pq_reassign_priority_handle(&pq, handles[index], &priorities[index], &oldPriority) == 0);
+            PQ_CHECK(oldPriority == &priorities[index]);
+            break;
+        default:
+            break;
+        }
+        expected[count] = priorities[index];
+        count += 1;
+    }
+    qsort(expected, count, sizeof(int), compare_int);
+    
+    PQ_CHECK(pq_size(&pq) == count);
+    for (index = 0; index < count; index += 1)
+        PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == expected[index]);
+    pq_destroy(&pq);
+}
+
+
+static void test_reassign_by_element(enum PQ_Engine_t engine) {
+    
+    PriorityQueue pq;
+    int newPriority;
+    void *priority, *elem, *oldPriority;
+    
+    if (pq_test_fill(&pq, engine, PQ_HEAP_MIN) != 0)
+        return;
+    
+    newPriority = -1;
+    PQ_CHECK(pq_reassign_priority(&pq, compare_int, &keys[PQ_TEST_COUNT / 2], &newPriority, &oldPriority) == 0);
+    PQ_CHECK(pq_peek_minimum(&pq, &priority, &elem) == 0 && priority == &newPriority);
+    newPriority = PQ_TEST_COUNT;
+    PQ_CHECK(pq_reassign_priority(&pq, compare_int, &newPriority, &newPriority, &oldPriority) == -2);
+    pq_destroy(&pq);
+}
+
+
+static void test_batch(enum PQ_Engine_t engine) {
+    
+    static const void *elems[PQ_TEST_COUNT];
+    PriorityQueue pq;
+    void *priority, *elem;
+    unsigned int index;
+    
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        elems[index] = &keys[index];
+    
+    /* A small batch is inserted one by one, the rest rebuilds the heap */
+    if (engine == PQ_ENGINE_RADIX_HEAP) {
+        PQ_CHECK(pq_test_init(&pq, engine, PQ_HEAP_MAX, 10) == 0);
+        PQ_CHECK(pq_insert_batch(&pq, elems, elems, 10) == 0);
+    }
+    else {
+        PQ_CHECK(pq_init_from_array(&pq, engine, PQ_HEAP_MAX, elems, elems, 10, compare_int, 0, 0) == 0);
+    }
+    PQ_CHECK(pq_insert_batch(&pq, elems + 10, elems + 10, 5) == 0);
+    PQ_CHECK(pq_insert_batch(&pq, elems + 15, elems + 15, PQ_TEST_COUNT - 15) == 0);
+    PQ_CHECK(pq_size(&pq) == PQ_TEST_COUNT);
+    for (index = PQ_TEST_COUNT; index > 0; index -= 1)
+        PQ_CHECK(pq_pull_maximum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index - 1]);
+    pq_destroy(&pq);
+    
+    /* A single node is a heap already, the build has nothing to sink */
+    if (engine != PQ_ENGINE_RADIX_HEAP) {
+        PQ_CHECK(pq_init_from_array(&pq, engine, PQ_HEAP_MIN, elems, elems, 1, compare_int, 0, 0) == 0);
+        PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && elem == elems[0]);
+        pq_destroy(&pq);
+    }
+}
+
+
+/* Every engine takes the nodes of every engine, a few of them and then many */
+static void test_merge(enum PQ_Engine_t engine) {
+    
+    PriorityQueue pq, other;
+    void *priority, *elem;
+    unsigned int source, index, split;
+    int orientation;
+    
+    split = PQ_TEST_COUNT / 2;
+    for (source = 0; source < PQ_TEST_ENGINE_COUNT; source += 1) {
+        for (orientation = PQ_HEAP_MIN; orientation <= PQ_HEAP_MAX; orientation += 1) {
+            PQ_CHECK(pq_test_init(&pq, engine, PQ_HEAP_MIN, 4) == 0);
+            PQ_CHECK(pq_test_init(&other, testEngines[source].engine, (enum PQ_HeapOrient_t) orientation, 4) == 0);
+            for (index = 0; index < split; index += 1)
+                PQ_CHECK(pq_insert_with_priority(&pq, &keys[index], &keys[index]) == 0);
+            for (index = split; index < split + 5; index += 1)
+                PQ_CHECK(pq_insert_with_priority(&other, &keys[index], &keys[index]) == 0);
+            PQ_CHECK(pq_merge(&pq, &other) == 0 && pq_size(&other) == 0);
+            for (index = split + 5; index < PQ_TEST_COUNT; index += 1)
+                PQ_CHECK(pq_insert_with_priority(&other, &keys[index], &keys[index]) == 0);
+            PQ_CHECK(pq_merge(&pq, &other) == 0 && pq_size(&other) == 0);
+            PQ_CHECK(pq_merge(&pq, &pq) == -1 && pq_size(&pq) == PQ_TEST_COUNT);
+            PQ_CHECK(pq_peek_maximum(&pq, &priority, &elem) == 0 &&
+                     *(int *) priority == sortedKeys[PQ_TEST_COUNT - 1]);
+    
+            for (index = 0; index < PQ_TEST_COUNT; index += 1)
+                PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    
+            /* The emptied source is still a working queue */
+            PQ_CHECK(pq_insert_with_priority(&other, &keys[0], &keys[0]) == 0);
+            PQ_CHECK(pq_pull_maximum(&other, &priority, &elem) == 0 && priority == &keys[0]);
+            pq_destroy(&pq);
+            pq_destroy(&other);
+        }
+    }
+}
+
+
+/* The export leaves the queue as it was, the drain leaves it empty */
+static void test_sorted(enum PQ_Engine_t engine, enum PQ_HeapOrient_t hOrientation) {
+    
+    static void *priorities[PQ_TEST_COUNT + 1], *elems[PQ_TEST_COUNT + 1];
+    PriorityQueue pq;
+    PQhandle handle;
+    void *priority, *elem;
+    unsigned int index;
+    
+    if (pq_test_fill(&pq, engine, hOrientation) != 0)
+        return;
+    PQ_CHECK(pq_insert_with_handle(&pq, &keys[0], &keys[0], &handle) == 0);
+    PQ_CHECK(pq_remove(&pq, handle, &priority, &elem) == 0);
+    
+    PQ_CHECK(pq_export_sorted(&pq, 1, priorities, elems) == 0);
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(*(int *) priorities[index] == sortedKeys[index] && elems[index] == priorities[index]);
+    PQ_CHECK(pq_export_sorted(&pq, 0, priorities, elems) == 0);
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(*(int *) priorities[index] == sortedKeys[PQ_TEST_COUNT - 1 - index]);
+    PQ_CHECK(pq_size(&pq) == PQ_TEST_COUNT);
+    PQ_CHECK(pq_peek_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[0]);
+    
+    PQ_CHECK(pq_insert_with_handle(&pq, &keys[0], &keys[0], &handle) == 0);
+    PQ_CHECK(pq_drain_sorted(&pq, hOrientation == PQ_HEAP_MIN, priorities, elems) == 0);
+    PQ_CHECK(pq_size(&pq) == 0 && pq_remove(&pq, handle, &priority, &elem) == -2);
+    PQ_CHECK(*(int *) priorities[0] == (hOrientation == PQ_HEAP_MIN ? sortedKeys[0] : sortedKeys[PQ_TEST_COUNT - 1]));
+    
+    /* The drained queue is still a working queue */
+    PQ_CHECK(pq_insert_with_priority(&pq, &keys[1], &keys[1]) == 0);
+    PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && priority == &keys[1]);
+    pq_destroy(&pq);
+}
+
+
+/*  Overwrite a number in a snapshot file. Its header holds the root of a pairing
+    heap at offset 28, the radix bucket starts or the pairing links follow at 64.
+*/
+static int patch_file(const char *path, long offset, unsigned int value) {
+    
+    FILE *file;
+    int result;
+    
+    file = fopen(path, "r+b");
+    if (file == 0)
+        return -1;
+    result = fseek(file, offset, SEEK_SET) == 0 && fwrite(&value, sizeof(value), 1, file) == 1 ? 0 : -1;
+    fclose(file);
+    return result;
+}
+
+
+/* A snapshot of every engine is restored into every engine, with flat keys and with serializers */
+static void test_snapshot(enum PQ_Engine_t engine) {
+    
+    static const char *path = "pq_test_snapshot.bin";
+    PQserializer flat, functions;
+    PriorityQueue pq, copy, merged;
+    void *priority, *elem;
+    unsigned int index, target, pulled;
+    FILE *file;
+    
+    memset((void *) &flat, 0, sizeof(flat));
+    flat.priorityBytes = sizeof(int);
+    flat.elementBytes = sizeof(int);
+    memset((void *) &functions, 0, sizeof(functions));
+    functions.fpSavePriority = save_int;
+    functions.fpSaveElement = save_int;
+    functions.fpLoadPriority = load_int;
+    functions.fpLoadElement = load_int;
+    
+    if (pq_test_fill(&pq, engine, PQ_HEAP_MAX) != 0)
+        return;
+    pulled = PQ_TEST_COUNT / 4;
+    for (index = 0; index < pulled; index += 1)
+        PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0);
+    PQ_CHECK(pq_snapshot_save(&pq, path, &flat) == 0);
+    
+    for (target = 0; target < PQ_TEST_ENGINE_COUNT; target += 1) {
+        PQ_CHECK(pq_test_init(&copy, testEngines[target].engine, PQ_HEAP_MAX, 4) == 0);
+        PQ_CHECK(pq_snapshot_load(&copy, path, &flat) == 0 && pq_size(&copy) == pq_size(&pq));
+        PQ_CHECK(pq_snapshot_load(&copy, path, &flat) == -1);
+        for (index = pulled; index < PQ_TEST_COUNT; index += 1)
+            PQ_CHECK(pq_pull_minimum(&copy, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index] &&
+                     *(int *) elem == sortedKeys[index]);
+        pq_destroy(&copy);
+    }
+    
+    /* A merge takes the mapping of the flat objects along, the source can be destroyed */
+    PQ_CHECK(pq_test_init(&merged, engine, PQ_HEAP_MAX, 4) == 0);
+    PQ_CHECK(pq_test_init(&copy, engine, PQ_HEAP_MAX, 4) == 0);
+    PQ_CHECK(pq_snapshot_load(&copy, path, &flat) == 0);
+    PQ_CHECK(pq_merge(&merged, &copy) == 0 && merged.pSnapshotMap != 0 && copy.pSnapshotMap == 0);
+    PQ_CHECK(pq_snapshot_load(&copy, path, &flat) == 0);
+    PQ_CHECK(pq_merge(&merged, &copy) == -1 && pq_size(&copy) == pq_size(&pq));
+    pq_destroy(&copy);
+    for (index = pulled; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_pull_minimum(&merged, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    pq_destroy(&merged);
+    
+    /* The objects made by the load functions belong to the queue */
+    PQ_CHECK(pq_snapshot_save(&pq, path, &functions) == 0);
+    if (engine == PQ_ENGINE_RADIX_HEAP)
+        PQ_CHECK(pq_init_radix(&copy, 4, 0, key_int, compare_int, free, free) == 0);
+    else
+        PQ_CHECK(pq_init_engine(&copy, engine, PQ_HEAP_MIN, 4, compare_int, free, free) == 0);
+    PQ_CHECK(pq_snapshot_load(&copy, path, &flat) == -1);
+    PQ_CHECK(pq_snapshot_load(&copy, path, &functions) == 0);
+    for (index = PQ_TEST_COUNT; index > pulled + 1; index -= 1) {
+        PQ_CHECK(pq_pull_maximum(&copy, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index - 1]);
+        free(priority);
+        free(elem);
+    }
+    pq_destroy(&copy);
+    
+    /* Saved radix buckets or pairing links which do not hold together restore nothing */
+    if (engine == PQ_ENGINE_RADIX_HEAP || engine == PQ_ENGINE_PAIRING_HEAP) {
+        PQ_CHECK(pq_snapshot_save(&pq, path, &flat) == 0);
+        PQ_CHECK(patch_file(path, engine == PQ_ENGINE_RADIX_HEAP ? 64 : 28, PQ_TEST_COUNT) == 0);
+        PQ_CHECK(pq_test_init(&copy, engine, PQ_HEAP_MAX, 4) == 0);
+        PQ_CHECK(pq_snapshot_load(&copy, path, &flat) == -3 && pq_size(&copy) == 0);
+        pq_destroy(&copy);
+    }
+    if (engine == PQ_ENGINE_PAIRING_HEAP) {
+        PQ_CHECK(pq_snapshot_save(&pq, path, &flat) == 0);
+        PQ_CHECK(patch_file(path, 64 + 4, 0) == 0);
+        PQ_CHECK(pq_test_init(&copy, engine, PQ_HEAP_MAX, 4) == 0);
+        PQ_CHECK(pq_snapshot_load(&copy, path, &flat) == -3 && pq_size(&copy) == 0);
+        pq_destroy(&copy);
+    }
+    
+    /* A damaged file restores nothing */
+    file = fopen(path, "r+b");
+    if (PQ_CHECK(file != 0)) {
+        fputc('X', file);
+        fclose(file);
+    }
+    PQ_CHECK(pq_test_init(&copy, engine, PQ_HEAP_MIN, 4) == 0);
+    PQ_CHECK(pq_snapshot_load(&copy, path, &flat) == -3 && pq_size(&copy) == 0);
+    pq_destroy(&copy);
+    
+    remove(path);
+    pq_destroy(&pq);
+}
+
+
+static void test_capacity(enum PQ_Engine_t engine) {
+    
+    PriorityQueue pq;
+    void *priority, *elem;
+    unsigned int index;
+    
+    if (PQ_CHECK(pq_test_init(&pq, engine, PQ_HEAP_MIN, 8) == 0) == 0)
+        return;
+    
+    PQ_CHECK(pq_set_growth_policy(&pq, 100, 25) == -1);
+    PQ_CHECK(pq_set_growth_policy(&pq, 150, 50) == 0);
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_insert_with_priority(&pq, &keys[index], &keys[index]) == 0);
+    PQ_CHECK(pq_capacity(&pq) >= PQ_TEST_COUNT);
+    
+    /* Draining shrinks the array, but never below the initial capacity */
+    for (index = 0; index < PQ_TEST_COUNT - 4; index += 1)
+        PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    PQ_CHECK(pq_capacity(&pq) < PQ_TEST_COUNT && pq_capacity(&pq) >= 8);
+    
+    PQ_CHECK(pq_reserve(&pq, 1000) == 0 && pq_capacity(&pq) >= 1000);
+    PQ_CHECK(pq_shrink_to_fit(&pq) == 0);
+    PQ_CHECK(pq_size(&pq) == 4);
+    for (; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    pq_destroy(&pq);
+}
+
+
+
+
+/* A key below the last pulled minimum turns the radix heap into a min binary heap */
+static void test_radix_fallback(void) {
+    
+    static const void *elems[PQ_TEST_COUNT];
+    PriorityQueue pq;
+    void *priority, *elem;
+    unsigned int index;
+    int low;
+    
+    currentTest = "radix";
+    PQ_CHECK(pq_init_radix(&pq, 4, 0, 0, compare_int, 0, 0) == -1);
+    PQ_CHECK(pq_init_engine(&pq, PQ_ENGINE_RADIX_HEAP, PQ_HEAP_MIN, 4, compare_int, 0, 0) == -1);
+    
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        elems[index] = &keys[index];
+    
+    /* Single inserts */
+    if (PQ_CHECK(pq_init_radix(&pq, 4, 0, key_int, compare_int, 0, 0) == 0) == 0)
+        return;
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_insert_with_priority(&pq, &keys[index], &keys[index]) == 0);
+    for (index = 0; index < PQ_TEST_COUNT / 2; index += 1)
+        PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    
+    PQ_CHECK(pq_insert_with_priority(&pq, &keys[0], &sortedKeys[PQ_TEST_COUNT / 2]) == 0);
+    PQ_CHECK(pq_engine(&pq) == PQ_ENGINE_RADIX_HEAP);
+    low = -1;
+    PQ_CHECK(pq_insert_with_priority(&pq, &keys[0], &low) == 0);
+    PQ_CHECK(pq_engine(&pq) == PQ_ENGINE_BINARY_HEAP && pq_rebuild_count(&pq) == 1);
+    PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && priority == &low);
+    PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[PQ_TEST_COUNT / 2]);
+    for (index = PQ_TEST_COUNT / 2; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    PQ_CHECK(pq_size(&pq) == 0);
+    pq_destroy(&pq);
+    
+    /* A batch falls back before any of its nodes is placed */
+    if (PQ_CHECK(pq_init_radix(&pq, 4, 0, key_int, compare_int, 0, 0) == 0) == 0)
+        return;
+    PQ_CHECK(pq_insert_batch(&pq, elems, elems, PQ_TEST_COUNT - 1) == 0);
+    PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0);
+    elems[PQ_TEST_COUNT - 2] = &low;
+    PQ_CHECK(pq_insert_batch(&pq, elems + PQ_TEST_COUNT - 2, elems + PQ_TEST_COUNT - 2, 2) == 0);
+    PQ_CHECK(pq_engine(&pq) == PQ_ENGINE_BINARY_HEAP && pq_size(&pq) == PQ_TEST_COUNT);
+    PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && priority == &low);
+    pq_destroy(&pq);
+}
+
+
+
+
+static void test_arena(void) {
+    
+    PQarena arena;
+    PQallocator allocator;
+    PriorityQueue pq[3];
+    void *priority, *elem;
+    unsigned int queue, index;
+    
+    currentTest = "arena";
+    PQ_CHECK(pq_arena_init(&arena, 0) == 0);
+    pq_arena_allocator(&arena, &allocator);
+    
+    for (queue = 0; queue < 3; queue += 1) {
+        PQ_CHECK(pq_init_allocator(&pq[queue], testEngines[queue].engine, PQ_HEAP_MIN, 16,
+                                   &allocator, compare_int, 0, 0) == 0);
+        for (index = 0; index < PQ_TEST_COUNT; index += 1)
+            PQ_CHECK(pq_insert_with_priority(&pq[queue], &keys[index], &keys[index]) == 0);
+    }
+    for (queue = 0; queue < 3; queue += 1)
+        for (index = 0; index < PQ_TEST_COUNT; index += 1)
+            PQ_CHECK(pq_pull_minimum(&pq[queue], &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    
+    pq_arena_release(&arena);
+}
+
+
+/*  Allocator whose reallocs fail once the given number of them has succeeded. Every
+    block carries its size in front of it, so the sizes passed back on realloc and
+    free can be checked against the allocator contract.
+*/
+typedef union {
+    size_t size;
+    long double alignLongDouble;
+    void *alignPointer;
+} FailingHeader;
+
+static unsigned int reallocsLeft = ~0u;
+
+static void *failing_alloc(void *context, size_t size) {
+    
+    FailingHeader *header;
+    
+    (void) context;
+    header = (FailingHeader *) malloc(sizeof(FailingHeader) + size);
+    if (header == 0)
+        return 0;
+    header->size = size;
+    return (void *) (header + 1);
+}
+
+
+static void *failing_realloc(void *context, void *block, size_t oldSize, size_t newSize) {
+    
+    FailingHeader *header;
+    
+    (void) context;
+    header = (FailingHeader *) block - 1;
+    PQ_CHECK(header->size == oldSize);
+    if (reallocsLeft == 0)
+        return 0;
+    reallocsLeft -= 1;
+    header = (FailingHeader *) realloc((void *) header, sizeof(FailingHeader) + newSize);
+    if (header == 0)
+        return 0;
+    header->size = newSize;
+    return (void *) (header + 1);
+}
+
+
+static void failing_free(void *context, void *block, size_t size) {
+    
+    FailingHeader *header;
+    
+    (void) context;
+    header = (FailingHeader *) block - 1;
+    PQ_CHECK(header->size == size);
+    free((void *) header);
+}
+
+
+/* A resize which fails half way never leaves the position map shorter than the nodes */
+static void test_failed_resize(void) {
+    
+    PQallocator allocator;
+    PriorityQueue pq;
+    PQhandle handle;
+    void *priority, *elem;
+    unsigned int engine, index, allowed, floor;
+    int result;
+    
+    currentTest = "failed resize";
+    allocator.fpAlloc = failing_alloc;
+    allocator.fpRealloc = failing_realloc;
+    allocator.fpFree = failing_free;
+    allocator.context = 0;
+    
+    /* The radix heap is initialized without an allocator */
+    for (engine = 0; engine < PQ_TEST_ENGINE_COUNT; engine += 1) {
+        if (testEngines[engine].engine == PQ_ENGINE_RADIX_HEAP)
+            continue;
+        for (allowed = 0; allowed < 3; allowed += 1) {
+            if (PQ_CHECK(pq_init_allocator(&pq, testEngines[engine].engine, PQ_HEAP_MIN, 16,
+                                           &allocator, compare_int, 0, 0) == 0) == 0)
+                continue;
+            PQ_CHECK(pq_insert_with_handle(&pq, &keys[0], &keys[0], &handle) == 0);
+            PQ_CHECK(pq_reserve(&pq, 2048) == 0);
+    
+            reallocsLeft = allowed;
+            PQ_CHECK(pq_shrink_to_fit(&pq) != -1);
+            floor = pq.minCapacity;
+            result = pq_reserve(&pq, 4096);
+            PQ_CHECK(result != -1 && pq.minCapacity == (result == 0 ? 4096u : floor));
+            reallocsLeft = ~0u;
+    
+            for (index = 1; index < PQ_TEST_COUNT; index += 1)
+                PQ_CHECK(pq_insert_with_handle(&pq, &keys[index], &keys[index], &handle) == 0);
+            for (index = 0; index < PQ_TEST_COUNT; index += 1)
+                PQ_CHECK(pq_pull_minimum(&pq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+            pq_destroy(&pq);
+        }
+    }
+}
+
+
+static void test_stats(void) {
+    
+    PriorityQueue pq;
+    PQstats stats;
+    void *priority, *elem;
+    int result;
+    
+    currentTest = "stats";
+    if (pq_test_fill(&pq, PQ_ENGINE_BINARY_HEAP, PQ_HEAP_MIN) != 0)
+        return;
+    
+    /* Enough pulls from the opposite end to rebuild the heap once */
+    while (pq_rebuild_count(&pq) == 0)
+        PQ_CHECK(pq_pull_maximum(&pq, &priority, &elem) == 0);
+    
+    result = pq_stats_get(&pq, &stats);
+#ifdef PQ_ENABLE_STATS
+    PQ_CHECK(result == 0);
+    PQ_CHECK(stats.comparisons > 0 && stats.nodeMoves > 0 && stats.expansions > 0);
+#else
+    PQ_CHECK(result == -3);
+    PQ_CHECK(stats.comparisons == 0);
+#endif
+    PQ_CHECK(stats.rebuilds == 1);
+    PQ_CHECK(stats.leafScans == pq_leaf_scan_count(&pq));
+    
+    PQ_CHECK(pq_stats_reset(&pq) == 0);
+    pq_stats_get(&pq, &stats);
+    PQ_CHECK(stats.comparisons == 0 && stats.rebuilds == 0 && pq_rebuild_count(&pq) == 0);
+    pq_destroy(&pq);
+}
+
+
+static void test_typed(void) {
+    
+    pq_u64 pq;
+    uint64_t priority, previous;
+    void *elem;
+    unsigned int index, capacity;
+    
+    currentTest = "typed";
+    if (PQ_CHECK(pq_u64_init(&pq, PQ_HEAP_MIN, 4, 0) == 0) == 0)
+        return;
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_u64_insert_with_priority(&pq, &keys[index], (uint64_t) keys[index]) == 0);
+    
+    PQ_CHECK(pq_u64_peek_maximum(&pq, &priority, &elem) == 0 && priority == (uint64_t) sortedKeys[PQ_TEST_COUNT - 1]);
+    previous = 0;
+    for (index = 0; index < PQ_TEST_COUNT; index += 1) {
+        if (PQ_CHECK(pq_u64_pull_minimum(&pq, &priority, &elem) == 0) == 0)
+            break;
+        PQ_CHECK(priority >= previous && priority == (uint64_t) *(int *) elem);
+        previous = priority;
+    }
+    PQ_CHECK(pq_u64_pull_minimum(&pq, &priority, &elem) != 0);
+    
+    /* A full array at the largest capacity refuses to grow instead of wrapping around */
+    capacity = pq.arrCapacity;
+    pq.nodeCount = PQ_CAPACITY_MAX;
+    pq.arrCapacity = PQ_CAPACITY_MAX;
+    PQ_CHECK(pq_u64_insert_with_priority(&pq, &keys[0], 1) == -2 && pq.arrCapacity == PQ_CAPACITY_MAX);
+    pq.nodeCount = 0;
+    pq.arrCapacity = capacity;
+    pq_u64_destroy(&pq);
+}
+
+
+
+
+struct PQtestWorker_ {
+    void *queue;
+    unsigned int first;
+    unsigned int count;
+};
+
+
+static void *concurrent_producer(void *arg) {
+    
+    struct PQtestWorker_ *worker = (struct PQtestWorker_ *) arg;
+    unsigned int index;
+    
+    for (index = worker->first; index < worker->first + worker->count; index += 1)
+        PQ_CHECK(pq_concurrent_insert_with_priority((PQconcurrent *) worker->queue, &keys[index], &keys[index]) == 0);
+    return 0;
+}
+
+
+static void *ingest_producer(void *arg) {
+    
+    struct PQtestWorker_ *worker = (struct PQtestWorker_ *) arg;
+    unsigned int index;
+    
+    for (index = worker->first; index < worker->first + worker->count; index += 1)
+        PQ_CHECK(pq_ingest_insert((PQingest *) worker->queue, &keys[index], &keys[index]) == 0);
+    return 0;
+}
+
+
+static void *relaxed_producer(void *arg) {
+    
+    struct PQtestWorker_ *worker = (struct PQtestWorker_ *) arg;
+    unsigned int index;
+    
+    for (index = worker->first; index < worker->first + worker->count; index += 1)
+        PQ_CHECK(pq_relaxed_insert_with_priority((PQrelaxed *) worker->queue, &keys[index], &keys[index]) == 0);
+    return 0;
+}
+
+
+static void pq_test_run_producers(void *queue, void *(*fpProducer) (void *)) {
+    
+    pthread_t threads[PQ_TEST_THREADS];
+    struct PQtestWorker_ workers[PQ_TEST_THREADS];
+    unsigned int thread;
+    
+    for (thread = 0; thread < PQ_TEST_THREADS; thread += 1) {
+        workers[thread].queue = queue;
+        workers[thread].first = thread * (PQ_TEST_COUNT / PQ_TEST_THREADS);
+        workers[thread].count = PQ_TEST_COUNT / PQ_TEST_THREADS;
+        PQ_CHECK(pthread_create(&threads[thread], 0, fpProducer, &workers[thread]) == 0);
+    }
+    for (thread = 0; thread < PQ_TEST_THREADS; thread += 1)
+        pthread_join(threads[thread], 0);
+}
+
+
+static void test_concurrent(void) {
+    
+    PQconcurrent cq;
+    void *priority, *elem;
+    unsigned int index;
+    
+    currentTest = "concurrent";
+    if (PQ_CHECK(pq_concurrent_init(&cq, PQ_ENGINE_MINMAX_HEAP, PQ_HEAP_MIN, 16, 0, compare_int, 0, 0) == 0) == 0)
+        return;
+    
+    pq_test_run_producers(&cq, concurrent_producer);
+    PQ_CHECK(pq_concurrent_size(&cq) == PQ_TEST_COUNT);
+    PQ_CHECK(pq_concurrent_peek_maximum(&cq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[PQ_TEST_COUNT - 1]);
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_concurrent_pull_minimum(&cq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    PQ_CHECK(pq_concurrent_pull_minimum(&cq, &priority, &elem) != 0);
+    pq_concurrent_destroy(&cq);
+}
+
+
+static void test_ingest(void) {
+    
+    PriorityQueue pq;
+    PQingest ring;
+    void *priority, *elem;
+    unsigned int index;
+    
+    currentTest = "ingest";
+    if (PQ_CHECK(pq_init(&pq, PQ_HEAP_MIN, 16, compare_int, 0, 0) == 0) == 0)
+        return;
+    
+    /* The capacity is rounded up to a power of 2, a full ring refuses more */
+    PQ_CHECK(pq_ingest_init(&ring, &pq, 3) == 0);
+    for (index = 0; index < 4; index += 1)
+        PQ_CHECK(pq_ingest_insert(&ring, &keys[index], &keys[index]) == 0);
+    PQ_CHECK(pq_ingest_insert(&ring, &keys[index], &keys[index]) == -3);
+    PQ_CHECK(pq_ingest_destroy(&ring) == 0);
+    PQ_CHECK(pq_size(&pq) == 4);
+    while (pq_size(&pq) != 0)
+        pq_pull_minimum(&pq, &priority, &elem);
+    
+    PQ_CHECK(pq_ingest_init(&ring, &pq, PQ_TEST_COUNT) == 0);
+    pq_test_run_producers(&ring, ingest_producer);
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_ingest_pull_minimum(&ring, &priority, &elem) == 0 && *(int *) priority == sortedKeys[index]);
+    
+    PQ_CHECK(pq_ingest_destroy(&ring) == 0);
+    pq_destroy(&pq);
+}
+
+
+/* The order is relaxed, only the count and the multiset of the keys are exact */
+static void test_relaxed(void) {
+    
+    static int pulled[PQ_TEST_COUNT];
+    PQallocator allocator;
+    PQrelaxed rq;
+    PQrelaxedStats stats;
+    void *priority, *elem;
+    unsigned int index;
+    
+    currentTest = "relaxed";
+    if (PQ_CHECK(pq_relaxed_init(&rq, 4, 0, PQ_TEST_COUNT, compare_int, 0, 0) == 0) == 0)
+        return;
+    PQ_CHECK(pq_relaxed_set_rank_sampling(&rq, 16) == 0);
+    
+    pq_test_run_producers(&rq, relaxed_producer);
+    PQ_CHECK(pq_relaxed_size(&rq) == PQ_TEST_COUNT);
+    for (index = 0; index < PQ_TEST_COUNT; index += 1) {
+        PQ_CHECK(pq_relaxed_pull_minimum(&rq, &priority, &elem) == 0);
+        pulled[index] = *(int *) priority;
+    }
+    PQ_CHECK(pq_relaxed_pull_minimum(&rq, &priority, &elem) == -1);
+    
+    qsort(pulled, PQ_TEST_COUNT, sizeof(int), compare_int);
+    PQ_CHECK(memcmp(pulled, sortedKeys, sizeof(sortedKeys)) == 0);
+    PQ_CHECK(pq_relaxed_get_stats(&rq, &stats) == 0 && stats.pullCount == PQ_TEST_COUNT);
+    PQ_CHECK(stats.sampleCount == PQ_TEST_COUNT / 16);
+    pq_relaxed_destroy(&rq);
+    
+    /* The heaps grow through the allocator, which is told the size of every block */
+    allocator.fpAlloc = failing_alloc;
+    allocator.fpRealloc = failing_realloc;
+    allocator.fpFree = failing_free;
+    allocator.context = 0;
+    if (PQ_CHECK(pq_relaxed_init_allocator(&rq, 4, 0, 4, &allocator, compare_int, 0, 0) == 0) == 0)
+        return;
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_relaxed_insert_with_priority(&rq, &keys[index], &keys[index]) == 0);
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(pq_relaxed_pull_minimum(&rq, &priority, &elem) == 0);
+    PQ_CHECK(pq_relaxed_size(&rq) == 0);
+    pq_relaxed_destroy(&rq);
+}
+
+
+/* The external queue owns its objects, a priority and an element of their own */
+static int external_insert(PQexternal *eq, int key) {
+    
+    int *priority, *elem;
+    
+    priority = (int *) malloc(sizeof(int));
+    elem = (int *) malloc(sizeof(int));
+    if (priority == 0 || elem == 0) {
+        free(priority);
+        free(elem);
+        return -2;
+    }
+    *priority = key;
+    *elem = key;
+    return pq_external_insert_with_priority(eq, elem, priority);
+}
+
+
+/* A queue with 64 elements in memory spills and merges runs, then serves both ends from them */
+static void test_external(enum PQ_Engine_t engine, const char *directory) {
+    
+    PQserializer functions;
+    PQexternal eq;
+    void *priority, *elem;
+    unsigned int index, low, high;
+    
+    currentTest = "external";
+    memset((void *) &functions, 0, sizeof(functions));
+    functions.fpSavePriority = save_int;
+    functions.fpSaveElement = save_int;
+    functions.fpLoadPriority = load_int;
+    functions.fpLoadElement = load_int;
+    
+    PQ_CHECK(pq_external_init(&eq, PQ_ENGINE_PAIRING_HEAP, PQ_HEAP_MIN, 64, 0, directory, &functions,
+                              compare_int, free, free) == -1);
+    PQ_CHECK(pq_external_init(&eq, engine, PQ_HEAP_MIN, 4, 0, directory, &functions,
+                              compare_int, free, free) == -1);
+    if (PQ_CHECK(pq_external_init(&eq, engine, PQ_HEAP_MIN, 64, 256, directory, &functions,
+                                  compare_int, free, free) == 0) == 0)
+        return;
+    
+    for (index = 0; index < PQ_TEST_COUNT; index += 1)
+        PQ_CHECK(external_insert(&eq, keys[index]) == 0);
+    PQ_CHECK(pq_external_size(&eq) == PQ_TEST_COUNT && pq_external_run_count(&eq) > 1);
+    PQ_CHECK(eq.spillCount > PQ_EXTERNAL_MERGE_FANOUT && eq.mergeCount > 0);
+    
+    /* Priority and element are separate objects once they come back from a run */
+    low = 0;
+    high = PQ_TEST_COUNT;
+    while (low < high) {
+        PQ_CHECK(pq_external_peek_minimum(&eq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[low]);
+        PQ_CHECK(pq_external_pull_minimum(&eq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[low] &&
+                 *(int *) elem == sortedKeys[low]);
+        free(priority);
+        free(elem);
+        low += 1;
+        if (low == high || low > PQ_TEST_COUNT / 2 - 100)
+            continue;
+        PQ_CHECK(pq_external_peek_maximum(&eq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[high - 1]);
+        PQ_CHECK(pq_external_pull_maximum(&eq, &priority, &elem) == 0 && *(int *) priority == sortedKeys[high - 1]);
+        free(priority);
+        free(elem);
+        high -= 1;
+    }
+    PQ_CHECK(pq_external_size(&eq) == 0 && pq_external_run_count(&eq) == 0);
+    PQ_CHECK(pq_external_pull_maximum(&eq, &priority, &elem) == -1);
+    
+    /* The elements left in memory and in the runs are destroyed with the queue */
+    for (index = 0; index < PQ_TEST_COUNT / 2; index += 1)
+        PQ_CHECK(external_insert(&eq, keys[index]) == 0);
+    PQ_CHECK(pq_external_pull_minimum(&eq, &priority, &elem) == 0);
+    free(priority);
+    free(elem);
+    pq_external_destroy(&eq);
+}
+
+
+
+
+int main(void) {
+    
+    unsigned int engine;
+    int orientation;
+    
+    pq_test_make_keys();
+    
+    for (engine = 0; engine < PQ_TEST_ENGINE_COUNT; engine += 1) {
+        currentTest = testEngines[engine].name;
+        for (orientation = PQ_HEAP_MIN; orientation <= PQ_HEAP_MAX; orientation += 1) {
+            test_pull_both_ends(testEngines[engine].engine, (enum PQ_HeapOrient_t) orientation);
+            test_k_operations(testEngines[engine].engine, (enum PQ_HeapOrient_t) orientation);
+            test_handles(testEngines[engine].engine, (enum PQ_HeapOrient_t) orientation);
+            test_sorted(testEngines[engine].engine, (enum PQ_HeapOrient_t) orientation);
+        }
+        test_opposite_end(testEngines[engine].engine);
+        test_reassign_by_element(testEngines[engine].engine);
+        test_batch(testEngines[engine].engine);
+        test_merge(testEngines[engine].engine);
+        test_snapshot(testEngines[engine].engine);
+        test_capacity(testEngines[engine].engine);
+    }
+    
+    test_radix_fallback();
+    test_arena();
+    test_failed_resize();
+    test_stats();
+    test_typed();
+    test_concurrent();
+    test_ingest();
+    test_relaxed();
+    test_external(PQ_ENGINE_MINMAX_HEAP, 0);
+    test_external(PQ_ENGINE_BINARY_HEAP, ".");
+    
+    if (failures != 0) {
+        fprintf(stderr, "%u checks failed\n", failures);
+        return 1;
+    }
+    printf("all tests passed\n");
+    return 0;
+}
+
+